@@ -60,6 +60,7 @@ void Console::reset(std::chrono::seconds timeout, const Timer& timer)
 	m_timer = timer;
 
 	m_solutions = 0;
+	m_orders = 0;
 	m_timeout = timeout;
 
 	clear();
@@ -95,7 +96,7 @@ void Console::done(EUCLIDE_Status status)
 	const bool exhaustive = !m_xsolutions || (m_solutions < m_xsolutions);
 
 	wchar_t string[32];
-	swprintf(string, countof(string), L"%24ls", m_strings[verdicts[std::min<int>(m_solutions, countof(verdicts) - 1)][exhaustive]]);
+	swprintf(string, countof(string), L"%24ls", m_strings[verdicts[std::min<int64_t>(m_orders, countof(verdicts) - 1)][exhaustive]]);
 	write(string, m_width - 25, 5, Colors::Verdict);
 
 	m_timer.stop();
@@ -155,7 +156,7 @@ void Console::displayOptions(const EUCLIDE_Options& options) const
 	m_stdout.displayOptions(options);
 	m_output.displayOptions(options);
 
-	m_xsolutions = std::max(0, options.maxSolutions);
+	m_xsolutions = options.countSolutions ? 0 : std::max(0, options.maxSolutions);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -234,6 +235,9 @@ void Console::displayThinking(const EUCLIDE_Thinking& thinking) const
 	m_stdout.displayThinking(thinking);
 	m_output.displayThinking(thinking);
 
+	if (thinking.solutions)
+		m_solutions = int(std::min<int64_t>(m_orders = thinking.solutions, std::numeric_limits<int>::max()));
+
 	wchar_t string[6 * countof(thinking.moves) + 1];
 	string[0] = '\0';
 
@@ -279,6 +283,7 @@ void Console::displayThinking(const EUCLIDE_Thinking& thinking) const
 void Console::displaySolution(const EUCLIDE_Solution& solution) const
 {
 	m_solutions = solution.solution;
+	m_orders += solution.numOrders;
 
 	m_stdout.displaySolution(solution);
 	m_output.displaySolution(solution);
@@ -87,6 +87,7 @@ class Console
 
 		mutable int m_xsolutions;          /**< Maximum number of solutions. */
 		mutable int m_solutions;           /**< Number of distinct solutions found. */
+		mutable int64_t m_orders;          /**< Number of proof games found, counting every move order of grouped solutions. */
 		std::chrono::seconds m_timeout;    /**< Timeout, in seconds. Zero if none. */
 
 	protected:
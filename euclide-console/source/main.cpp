@@ -13,8 +13,12 @@ struct Options
 	int timeout = 0;         /**< Timeout, in seconds, before aborting solving for a problem. */
 	int solutions = 8;       /**< Maximum number of solutions, before aborting solving for a problem. */
 	bool contest = false;    /**< Solving contest mode. */
+	bool group = false;      /**< Report solutions only differing by move order once. */
+	bool count = false;      /**< Only count solutions. */
 
 	int threads = 0;         /**< Number of threads used for batch solving. */
+	int searchThreads = 0;   /**< Number of threads used to solve a single problem. */
+	int hashSize = 0;        /**< Hash table size, in megabytes. */
 };
 
 /* -------------------------------------------------------------------------- */
@@ -32,6 +36,10 @@ bool solve(Console& console, const ForsytheString& problem, const Options& optio
 	EUCLIDE_Options configuration = {};
 	configuration.maxSolutions = options.solutions;
 	configuration.solvingContest = options.contest;
+	configuration.groupSolutions = options.group;
+	configuration.countSolutions = options.count;
+	configuration.numThreads = options.searchThreads;
+	configuration.hashTableSize = options.hashSize;
 
 	const EUCLIDE_Status status = EUCLIDE_solve(&configuration, problem, console);
 
@@ -256,6 +264,16 @@ int euclide(int numArguments, char *arguments[], char * /*environment*/[])
 			options.contest = true;
 		}
 		else
+		if (strcmp(arguments[argument], "--group") == 0)
+		{
+			options.group = true;
+		}
+		else
+		if (strcmp(arguments[argument], "--count") == 0)
+		{
+			options.count = true;
+		}
+		else
 		if (strcmp(arguments[argument], "--threads") == 0)
 		{
 			if (++argument < numArguments)
@@ -269,6 +287,32 @@ int euclide(int numArguments, char *arguments[], char * /*environment*/[])
 			options.threads = atoi(arguments[argument] + strlen("--threads="));
 		}
 		else
+		if (strcmp(arguments[argument], "--search-threads") == 0)
+		{
+			if (++argument < numArguments)
+				options.searchThreads = atoi(arguments[argument]);
+			else
+				error = Strings::InvalidArguments;
+		}
+		else
+		if (strncmp(arguments[argument], "--search-threads=", strlen("--search-threads=")) == 0)
+		{
+			options.searchThreads = atoi(arguments[argument] + strlen("--search-threads="));
+		}
+		else
+		if (strcmp(arguments[argument], "--hash-size") == 0)
+		{
+			if (++argument < numArguments)
+				options.hashSize = atoi(arguments[argument]);
+			else
+				error = Strings::InvalidArguments;
+		}
+		else
+		if (strncmp(arguments[argument], "--hash-size=", strlen("--hash-size=")) == 0)
+		{
+			options.hashSize = atoi(arguments[argument] + strlen("--hash-size="));
+		}
+		else
 		if (strcmp(arguments[argument], "--quiet") == 0)
 		{
 			options.quiet = true;
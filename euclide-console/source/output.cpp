@@ -91,8 +91,14 @@ void Output::reset()
 	m_timer = Timer();
 	m_complexity = 0.0;
 	m_positions = 0;
+	m_hashHits = 0;
+	m_hashMisses = 0;
+	m_hashEvictions = 0;
+	m_hashProbes = 0;
 	m_xsolutions = 0;
 	m_solutions = 0;
+	m_orders = 0;
+	m_counted = 0;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -107,6 +113,10 @@ void Output::done(EUCLIDE_Status status)
 			fprintf(m_file, "\t%ls %.2f\n", m_strings[Strings::Score], m_complexity);
 			if (m_positions)
 				fprintf(m_file, "\t%ls %" PRId64 "\n", m_strings[Strings::Positions], m_positions);
+			if (m_hashHits + m_hashMisses)
+				fprintf(m_file, "\t%ls %" PRId64 " / %" PRId64 " / %" PRId64 " / %" PRId64 "\n", m_strings[Strings::HashTable], m_hashHits, m_hashMisses, m_hashEvictions, m_hashProbes);
+			if (m_counted)
+				fprintf(m_file, "\t%ls %" PRId64 "\n", m_strings[Strings::Solutions], m_counted);
 
 			const Strings::String verdicts[6][2] = {
 				{ Strings::NoSolution, Strings::NoSolution},
@@ -120,7 +130,7 @@ void Output::done(EUCLIDE_Status status)
 			const bool exhaustive = !m_xsolutions || (m_solutions < m_xsolutions);
 
 			if (m_positions)
-				fprintf(m_file, "\t%ls\n", m_strings[verdicts[std::min<int>(m_solutions, countof(verdicts) - 1)][exhaustive]]);
+				fprintf(m_file, "\t%ls\n", m_strings[verdicts[std::min<int64_t>(m_orders, countof(verdicts) - 1)][exhaustive]]);
 		}
 		else
 		if (status == EUCLIDE_STATUS_ABORTED)
@@ -155,7 +165,7 @@ void Output::displayCopyright(const wchar_t *copyright) const
 
 void Output::displayOptions(const EUCLIDE_Options& options) const
 {
-	m_xsolutions = std::max(0, options.maxSolutions);
+	m_xsolutions = options.countSolutions ? 0 : std::max(0, options.maxSolutions);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -235,6 +245,13 @@ void Output::displayDeductions(const EUCLIDE_Deductions& deductions) const
 void Output::displayThinking(const EUCLIDE_Thinking& thinking) const
 {
 	m_positions = thinking.positions;
+	m_hashHits = thinking.hashHits;
+	m_hashMisses = thinking.hashMisses;
+	m_hashEvictions = thinking.hashEvictions;
+	m_hashProbes = thinking.hashProbes;
+
+	if (thinking.solutions)
+		m_solutions = int(std::min<int64_t>(m_orders = m_counted = thinking.solutions, std::numeric_limits<int>::max()));
 }
 
 /* -------------------------------------------------------------------------- */
@@ -243,7 +260,10 @@ void Output::displaySolution(const EUCLIDE_Solution& solution) const
 {
 	if (m_file)
 	{
-		fprintf(m_file, "%ls%d%ls\n", m_strings[Strings::Solution], solution.solution, m_strings[Strings::Colon]);
+		if (solution.numOrders > 1)
+			fprintf(m_file, "%ls%d%ls %d %ls\n", m_strings[Strings::Solution], solution.solution, m_strings[Strings::Colon], solution.numOrders, m_strings[Strings::MoveOrders]);
+		else
+			fprintf(m_file, "%ls%d%ls\n", m_strings[Strings::Solution], solution.solution, m_strings[Strings::Colon]);
 		fprintf(m_file, "%ls\n", Hyphens);
 
 		const int black = (solution.moves[0].glyph & 1) ^ 1;
@@ -284,6 +304,7 @@ void Output::displaySolution(const EUCLIDE_Solution& solution) const
 	}
 
 	m_solutions += 1;
+	m_orders += solution.numOrders;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -60,8 +60,14 @@ class Output
 		Timer m_timer;                    /**< Timer used to output total solving time. */
 		mutable double m_complexity;      /**< Solving complexity, only the last value is written to file. */
 		mutable int64_t m_positions;      /**< Number of positions examined. */
+		mutable int64_t m_hashHits;       /**< Number of positions found in hash table. */
+		mutable int64_t m_hashMisses;     /**< Number of positions not found in hash table. */
+		mutable int64_t m_hashEvictions;  /**< Number of hash table entries replaced. */
+		mutable int64_t m_hashProbes;     /**< Number of hash table entries examined. */
 		mutable int m_xsolutions;         /**< Maximum number of solutions. */
 		mutable int m_solutions;          /**< Number of solutions found. */
+		mutable int64_t m_orders;         /**< Number of proof games found, counting every move order of grouped solutions. */
+		mutable int64_t m_counted;        /**< Number of solutions counted, when counting solutions. */
 
 	private :
 		static const wchar_t *Hyphens;
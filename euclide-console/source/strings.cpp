@@ -46,6 +46,7 @@ static const wchar_t *frenchStrings[] =
 	L"Verdict :",
 	L"\xC9" L"chelle de difficult\xE9 =",
 	L"Positions examin\xE9" L"es :",
+	L"Table de hachage (succ\xE8s / \xE9" L"checs / remplacements / sondages) :",
 	L"Solution n\xB0 ",
 	L" :",
 	L"Aucune solution",
@@ -58,7 +59,9 @@ static const wchar_t *frenchStrings[] =
 	L"Deux solutions ou plus",
 	L"Trois solutions ou plus",
 	L"Quatre solutions ou plus",
-	L"Probl\xE8me d\xE9moli"
+	L"Probl\xE8me d\xE9moli",
+	L"ordres de coups",
+	L"Solutions :"
 };
 
 static const wchar_t *frenchStatuses[] =
@@ -115,6 +118,7 @@ static const wchar_t *englishStrings[] =
 	L"Result:",
 	L"Complexity:",
 	L"Positions:",
+	L"Hash table (hits / misses / evictions / probes):",
 	L"Solution #",
 	L":",
 	L"No solution",
@@ -127,7 +131,9 @@ static const wchar_t *englishStrings[] =
 	L"At least two solutions",
 	L"At least three solutions",
 	L"At least four solutions",
-	L"Cooked"
+	L"Cooked",
+	L"move orders",
+	L"Solutions:"
 };
 
 static const wchar_t *englishStatuses[] =
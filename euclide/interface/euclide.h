@@ -223,6 +223,12 @@ typedef struct
 	int numHalfMoves;                     /**< Number of moves in above array. */
 
 	int64_t positions;                    /**< Number of positions examined. */
+	int64_t solutions;                    /**< Number of solutions counted, when counting solutions. Saturates at INT64_MAX. */
+
+	int64_t hashHits;                     /**< Number of positions found in hash table. */
+	int64_t hashMisses;                   /**< Number of positions looked up but not found in hash table. */
+	int64_t hashEvictions;                /**< Number of hash table entries replaced by other positions. */
+	int64_t hashProbes;                   /**< Number of hash table entries examined by lookups. Divide by number of lookups for average probe length. */
 
 } EUCLIDE_Thinking;
 
@@ -232,6 +238,7 @@ typedef struct
 {
 	EUCLIDE_Move moves[128];              /**< Moves played. */
 	int numHalfMoves;                     /**< Number of moves in above array. */
+	int numOrders;                        /**< Number of legal orders of the moves of this solution. Always one unless grouping solutions. */
 
 	int solution;                         /**< Number of solutions found so far, counting from 1. */
 
@@ -243,6 +250,10 @@ typedef struct
 {
 	bool solvingContest;                  /**< Solving contest mode; non dualistic solutions are found faster. */
 	int maxSolutions;                     /**< Solving stops (returns OK) when reaching this number of solutions. Zero means unlimited searching. */
+	int numThreads;                       /**< Number of threads used to analyze and search for solutions of a single problem. Zero or one means single threaded. */
+	int hashTableSize;                    /**< Hash table memory budget, in megabytes. Zero means default size. */
+	bool groupSolutions;                  /**< Solutions that only differ by move order are reported once, with their number of move orders. */
+	bool countSolutions;                  /**< Solutions are only counted, in thinking callbacks, rather than reported one by one. Implies exhaustive search, ignores maximum number of solutions. */
 
 } EUCLIDE_Options;
 
@@ -9,9 +9,20 @@ namespace Euclide
 
 TwoPieceFastCache::TwoPieceFastCache()
 {
-	const Entry entry = { Infinity, Infinity };
-	const Line line = { entry, entry, entry };
-	m_cache.fill(line);
+	/* -- Cache lines are emptied when first used -- */
+
+	m_generations.fill(0);
+	m_generation = 1;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void TwoPieceFastCache::reset()
+{
+	/* -- Empty all cache lines at once by starting a new generation -- */
+
+	if (++m_generation == 0)
+		m_generations.fill(0), m_generation = 1;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -20,6 +31,15 @@ void TwoPieceFastCache::add(Square squareA, int movesA, Square squareB, int move
 {
 	Line& line = m_cache[squareA][squareB];
 
+	/* -- Empty cache line if it was filled before last reset -- */
+
+	if (m_generations[squareA][squareB] != m_generation)
+	{
+		const Entry entry = { Infinity, Infinity };
+		line.fill(entry);
+		m_generations[squareA][squareB] = m_generation;
+	}
+
 	/* -- This is our new cache entry -- */
 
 	const Entry entry = { short(movesA), short(movesB) };
@@ -47,6 +67,9 @@ void TwoPieceFastCache::add(Square squareA, int movesA, Square squareB, int move
 
 bool TwoPieceFastCache::hit(Square squareA, int movesA, Square squareB, int movesB) const
 {
+	if (m_generations[squareA][squareB] != m_generation)
+		return false;
+
 	const Line& line = m_cache[squareA][squareB];
 
 	for (const Entry& cache : line)
@@ -78,16 +101,23 @@ bool TwoPieceFastCache::hit(const Position& position) const
 template<typename State>
 TwoPieceFullCache<State>::TwoPieceFullCache()
 {
-#if 1
-	const Entry entry = { false, Infinity, Infinity, Infinity, State(), State() };
-	const Line line = { entry, entry, entry, entry, entry, entry, entry, entry };
-	m_cache.fill(line);
-#else
-	for (Square squareA : AllSquares())
-		for (Square squareB : AllSquares())
-			for (Entry& entry : m_cache[squareA][squareB])
-				entry.valid = false;
-#endif
+	/* -- Cache lines are emptied when first used -- */
+
+	m_generations.fill(0);
+	m_generation = 1;
+
+	m_id = 0;
+}
+
+/* -------------------------------------------------------------------------- */
+
+template<typename State>
+void TwoPieceFullCache<State>::reset()
+{
+	/* -- Empty all cache lines at once by starting a new generation -- */
+
+	if (++m_generation == 0)
+		m_generations.fill(0), m_generation = 1;
 
 	m_id = 0;
 }
@@ -99,6 +129,16 @@ void TwoPieceFullCache<State>::add(Square squareA, int movesA, State stateA, Squ
 {
 	Line& line = m_cache[squareA][squareB];
 
+	/* -- Empty cache line if it was filled before last reset -- */
+
+	if (m_generations[squareA][squareB] != m_generation)
+	{
+		for (Entry& cache : line)
+			cache.valid = false;
+
+		m_generations[squareA][squareB] = m_generation;
+	}
+
 	/* -- This is our new cache entry -- */
 
 	const Entry entry = { true, short(movesA), short(movesB), short(requiredMoves), stateA, stateB };
@@ -130,6 +170,9 @@ void TwoPieceFullCache<State>::add(Square squareA, int movesA, State stateA, Squ
 template<typename State>
 bool TwoPieceFullCache<State>::hit(Square squareA, int movesA, State stateA, Square squareB, int movesB, State stateB, int *requiredMoves) const
 {
+	if (m_generations[squareA][squareB] != m_generation)
+		return false;
+
 	const Line& line = m_cache[squareA][squareB];
 
 	/* -- Check if we have already reached this configuration in less or equal moves -- */
@@ -23,6 +23,7 @@ class TwoPieceFastCache
 
 	public:
 		TwoPieceFastCache();
+		void reset();
 
 		void add(Square squareA, int movesA, Square squareB, int movesB);
 		bool hit(Square squareA, int movesA, Square squareB, int movesB) const;
@@ -34,6 +35,9 @@ class TwoPieceFastCache
 		typedef struct { short movesA, movesB; } Entry;
 		typedef array<Entry, 3> Line;                    /**< A cache line is made of up to three elements. */
 		matrix<Line, NumSquares, NumSquares> m_cache;    /**< Cache, one line for each pair of squares. */
+
+		matrix<unsigned, NumSquares, NumSquares> m_generations;    /**< Generation of each cache line, lines of older generations are empty. */
+		unsigned m_generation;                                     /**< Current generation, incremented on reset. */
 };
 
 /* -------------------------------------------------------------------------- */
@@ -55,6 +59,7 @@ class TwoPieceFullCache
 
 	public:
 		TwoPieceFullCache();
+		void reset();
 
 		void add(Square squareA, int movesA, State stateA, Square squareB, int movesB, State stateB, int requiredMoves);
 		bool hit(Square squareA, int movesA, State stateA, Square squareB, int movesB, State stateB, int *requiredMoves) const;
@@ -67,6 +72,9 @@ class TwoPieceFullCache
 		typedef array<Entry, 8> Line;                    /**< A cache line is made of up to eight elements. */
 		matrix<Line, NumSquares, NumSquares> m_cache;    /**< Cache, one line for each pair of squares. */
 
+		matrix<unsigned, NumSquares, NumSquares> m_generations;    /**< Generation of each cache line, lines of older generations are empty. */
+		unsigned m_generation;                                     /**< Current generation, incremented on reset. */
+
 		unsigned m_id;                                   /**< Id used as pseudo-random number to replace cache entries where there is no space left. */
 };
 
@@ -85,44 +85,4 @@ bool Capture::updatePossibleMen(Men men, Men xmen)
 
 /* -------------------------------------------------------------------------- */
 
-bool Capture::applyPigeonHolePrinciple(Targets& targets, Captures& captures) const
-{
-	bool updated = false;
-
-	const int count = xstd::sum(captures, [=](const Capture& capture) { return (capture.men() == m_men) ? 1 : 0; });
-	if (count >= m_men.count())
-	{
-		for (Target& target : targets)
-			if (target.updatePossibleMen(~m_men))
-				updated = true;
-
-		for (Capture& capture : captures)
-			if (capture.men() != m_men)
-				if (capture.updatePossibleMen(~m_men, capture.xmen()))
-					updated = true;
-	}
-
-	return updated;
-}
-
-/* -------------------------------------------------------------------------- */
-/* -- Captures                                                             -- */
-/* -------------------------------------------------------------------------- */
-
-bool Captures::update(Targets& targets)
-{
-	bool reduced = false;
-	for (bool updated = true; updated; reduced |= updated)
-	{
-		updated = false;
-		for (const Capture& capture : *this)
-			if (capture.applyPigeonHolePrinciple(targets, *this))
-				updated = true;
-	}
-
-	return reduced;
-}
-
-/* -------------------------------------------------------------------------- */
-
 }
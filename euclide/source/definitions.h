@@ -13,6 +13,8 @@ namespace Euclide
 static const int MaxPieces = 32;
 static const int MaxMoves = 128;
 
+static const int DefaultHashTableSize = 512;
+
 /* -------------------------------------------------------------------------- */
 /* -- Status                                                               -- */
 /* -------------------------------------------------------------------------- */
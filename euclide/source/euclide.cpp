@@ -26,6 +26,10 @@ class Euclide
 		bool update(std::vector<Piece *>& pieces);
 		bool triangulation();
 
+		void parallel(size_t tasks, const std::function<void(size_t)>& task);
+		void work();
+		void worker(unsigned round);
+
 		const EUCLIDE_Deductions& deductions() const;
 
 	private:
@@ -41,8 +45,21 @@ class Euclide
 		array<int, NumColors> m_freeMoves;          /**< Unassigned moves. */
 		array<int, NumColors> m_freeCaptures;       /**< Unassigned captures. */
 
-		struct Tandem { const Piece& pieceA; const Piece& pieceB; int requiredMoves; Tandem(const Piece& pieceA, const Piece& pieceB, int requiredMoves) : pieceA(pieceA), pieceB(pieceB), requiredMoves(requiredMoves) {}};
-		std::vector<Tandem> m_tandems;              /**< Required moves for pair of pieces. */
+		Tandems m_tandems;                          /**< Required moves for pair of pieces. */
+
+	private:
+		std::vector<std::thread> m_workers;         /**< Worker threads for concurrent analysis, kept until solving is done. */
+		std::mutex m_mutex;                         /**< Protects worker pool state below. */
+		std::condition_variable m_wakeup;           /**< Signals workers that tasks are available or that they should exit. */
+		std::condition_variable m_finished;         /**< Signals that all workers are done with current tasks. */
+		unsigned m_round;                           /**< Incremented each time tasks are submitted to workers. */
+		unsigned m_busy;                            /**< Number of workers still working on current tasks. */
+		bool m_exiting;                             /**< Set when workers should exit. */
+
+		const std::function<void(size_t)> *m_task;  /**< Current task, called with each task index. */
+		size_t m_tasks;                             /**< Number of current tasks. */
+		std::atomic<size_t> m_next;                 /**< Index of next task to perform. */
+		std::vector<Status> m_statuses;             /**< Status of each current task. */
 
 	private:
 		mutable EUCLIDE_Deductions m_deductions;    /**< Temporary variable to hold deductions for corresponding user callback. */
@@ -51,7 +68,7 @@ class Euclide
 /* -------------------------------------------------------------------------- */
 
 Euclide::Euclide(const EUCLIDE_Options& options, const EUCLIDE_Callbacks& callbacks)
-	: m_options(options), m_callbacks(callbacks)
+	: m_options(options), m_callbacks(callbacks), m_round(0), m_busy(0), m_exiting(false), m_task(nullptr), m_tasks(0), m_next(0)
 {
 	/* -- Display copyright string -- */
 
@@ -68,6 +85,16 @@ Euclide::Euclide(const EUCLIDE_Options& options, const EUCLIDE_Callbacks& callba
 
 Euclide::~Euclide()
 {
+	/* -- Stop worker threads -- */
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_exiting = true;
+	}
+
+	m_wakeup.notify_all();
+	for (std::thread& worker : m_workers)
+		worker.join();
 }
 
 /* -------------------------------------------------------------------------- */
@@ -158,6 +185,17 @@ void Euclide::solve(const EUCLIDE_Problem& problem)
 	bool consequences = false;
 	bool triangulations = false;
 
+	/* -- Interactions between pairs of pieces, kept until one of the pieces is updated -- */
+
+	struct Interactions
+	{
+		array<int, 2> epochs;                                   /**< Epochs of both pieces when interactions were computed. */
+		array<int, NumColors> freeMoves;                        /**< Free moves when interactions were computed. */
+		std::unique_ptr<Piece::Interactions> interactions;      /**< Interactions between both pieces. */
+	};
+
+	std::map<std::pair<const Piece *, const Piece *>, Interactions> interactions;
+
 	for (bool loop = true; loop; )
 	{
 		/* -- Compute free moves and captures -- */
@@ -235,7 +273,7 @@ void Euclide::solve(const EUCLIDE_Problem& problem)
 							xpieces[xman].setVisitedSquares(squares);
 					}
 
-				} while (targets.update(captures) || captures.update(targets));
+				} while (targets.update(captures));
 
 				/* -- Merge targets into partitions -- */
 
@@ -361,17 +399,48 @@ void Euclide::solve(const EUCLIDE_Problem& problem)
 
 		/* -- Mutual obstructions between two pieces -- */
 
-		m_tandems.clear();
+		std::vector<std::pair<Piece *, Piece *>> pairs;
 		for (unsigned pieceA = 0; pieceA < pieces.size(); pieceA++)
-		{
 			for (unsigned pieceB = pieceA + 1; pieceB < pieces.size(); pieceB++)
+				pairs.emplace_back(pieces[pieceA], pieces[pieceB]);
+
+		/* -- Find pairs for which one of the pieces, or the number of free moves, changed since last time -- */
+
+		std::vector<std::pair<Piece *, Piece *>> outdated;
+		for (const std::pair<Piece *, Piece *>& pair : pairs)
+		{
+			Interactions& interaction = interactions[pair];
+			const array<int, 2> epochs = {{ pair.first->epoch(), pair.second->epoch() }};
+
+			if (!interaction.interactions || (interaction.epochs != epochs) || (interaction.freeMoves != m_freeMoves))
 			{
-				const int requiredMoves = Piece::mutualInteractions(*pieces[pieceA], *pieces[pieceB], m_freeMoves, false);
-				if (requiredMoves > pieces[pieceA]->requiredMoves() + pieces[pieceB]->requiredMoves())
-					m_tandems.emplace_back(*pieces[pieceA], *pieces[pieceB], requiredMoves);
+				interaction.epochs = epochs;
+				interaction.freeMoves = m_freeMoves;
+				interaction.interactions.reset();
+				outdated.push_back(pair);
 			}
 		}
 
+		/* -- Analyze these pairs concurrently, pieces are left untouched until all pairs are done -- */
+
+		parallel(outdated.size(), [&](size_t k) {
+			interactions.at(outdated[k]).interactions.reset(new Piece::Interactions(*outdated[k].first, *outdated[k].second, m_freeMoves, false));
+		});
+
+		/* -- Merge results in pair order, pairs with a piece changed by a previous pair are analyzed again, as they would be without concurrency -- */
+
+		m_tandems.clear();
+		for (size_t k = 0; k < pairs.size(); k++)
+		{
+			Interactions& interaction = interactions.at(pairs[k]);
+			if (pairs[k].first->updated() || pairs[k].second->updated())
+				interaction.interactions.reset(new Piece::Interactions(*pairs[k].first, *pairs[k].second, m_freeMoves, false));
+
+			const int requiredMoves = interaction.interactions->apply();
+			if (requiredMoves > pairs[k].first->requiredMoves() + pairs[k].second->requiredMoves())
+				m_tandems.emplace_back(*pairs[k].first, *pairs[k].second, requiredMoves);
+		}
+
 		/* -- Update pieces -- */
 
 		if (update(pieces))
@@ -394,9 +463,12 @@ void Euclide::solve(const EUCLIDE_Problem& problem)
 				for (Piece& piece : m_pieces[color])
 					piece.initializeActions();
 
-			for (Color color : AllColors())
-				for (Piece& piece : m_pieces[color])
-					piece.findConsequences(m_pieces);
+			/* -- Each piece only updates consequences of its own moves, so pieces can be handled concurrently -- */
+
+			Piece::Obstructions obstructions;
+			parallel(pieces.size(), [&](size_t k) {
+				pieces[k]->findConsequences(m_pieces, obstructions);
+			});
 
 			consequences = true;
 			//continue;
@@ -414,7 +486,7 @@ void Euclide::solve(const EUCLIDE_Problem& problem)
 
 	/* -- Play all possible games -- */
 
-	std::unique_ptr<Game> game(new Game(m_options, m_callbacks, m_problem, m_pieces, m_freeMoves));
+	std::unique_ptr<Game> game(new Game(m_options, m_callbacks, m_problem, m_pieces, m_tandems, m_freeMoves));
 	game->play();
 }
 
@@ -433,6 +505,93 @@ bool Euclide::update(std::vector<Piece *>& pieces)
 
 /* -------------------------------------------------------------------------- */
 
+void Euclide::parallel(size_t tasks, const std::function<void(size_t)>& task)
+{
+	/* -- Start worker threads on first use, they are reused for all further tasks -- */
+
+	const size_t numThreads = std::max(m_options.numThreads, 1);
+	while (m_workers.size() + 1 < numThreads)
+		m_workers.emplace_back(&Euclide::worker, this, m_round);
+
+	/* -- Submit tasks to workers -- */
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		m_task = &task;
+		m_tasks = tasks;
+		m_next = 0;
+		m_statuses.assign(tasks, Ok);
+
+		m_busy = unsigned(m_workers.size());
+		m_round += 1;
+	}
+
+	m_wakeup.notify_all();
+
+	/* -- Work on tasks too, then wait for workers -- */
+
+	work();
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_finished.wait(lock, [&]() { return m_busy == 0; });
+	m_task = nullptr;
+
+	/* -- Forward status of first failed task, so that errors do not depend on scheduling -- */
+
+	for (Status status : m_statuses)
+		if (status != Ok)
+			throw status;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Euclide::work()
+{
+	/* -- Pick next task until there are none left -- */
+
+	for (size_t k = m_next++; k < m_tasks; k = m_next++)
+	{
+		try
+		{
+			(*m_task)(k);
+		}
+		catch (Status status)
+		{
+			m_statuses[k] = status;
+		}
+		catch (std::bad_alloc&)
+		{
+			m_statuses[k] = OutOfMemory;
+		}
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Euclide::worker(unsigned round)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	/* -- Wait for tasks submitted after given round, until exiting -- */
+
+	for ( ; ; round = m_round)
+	{
+		m_wakeup.wait(lock, [&]() { return m_exiting || (m_round != round); });
+		if (m_exiting)
+			break;
+
+		lock.unlock();
+		work();
+		lock.lock();
+
+		if (--m_busy == 0)
+			m_finished.notify_one();
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
 bool Euclide::triangulation()
 {
 	bool updated = false;
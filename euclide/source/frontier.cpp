@@ -0,0 +1,298 @@
+#include "frontier.h"
+#include "pieces.h"
+#include "problem.h"
+#include "tables/tables.h"
+
+namespace Euclide
+{
+
+/* -------------------------------------------------------------------------- */
+/* -- Frontier                                                             -- */
+/* -------------------------------------------------------------------------- */
+
+Frontier::Frontier(const Problem& problem, const array<Pieces, NumColors>& pieces, size_t memory)
+	: m_problem(problem)
+{
+	/* -- Only orthodox chess is supported, other variants have different castling and promotion rules -- */
+
+	if (problem.variant() != Orthodox)
+		return;
+
+	/* -- Initialize reverse movement tables and check tables -- */
+
+	for (Glyph glyph : MostGlyphs())
+	{
+		const Species species = problem.piece(glyph);
+
+		ArrayOfSquares moves;
+		Tables::initializeLegalMoves(&moves, species, color(glyph), problem.variant(), unknown, true);
+		const ArrayOfSquares& xmoves = *Tables::getCaptureMoves(species, color(glyph), problem.variant(), false);
+
+		for (Square from : AllSquares())
+		{
+			for (Square to : ValidSquares(moves[from]))
+			{
+				m_rmoves[glyph][to].set(from);
+				if (xmoves[from][to])
+					m_rxmoves[glyph][to].set(from);
+			}
+		}
+
+		m_constraints[glyph] = Tables::getMoveConstraints(species, problem.variant(), false, false);
+		m_xconstraints[glyph] = Tables::getMoveConstraints(species, problem.variant(), true, false);
+
+		Tables::initializeLegalMoves(&m_checks[glyph], species, color(glyph), problem.variant(), true, true);
+	}
+
+	/* -- Squares on which each glyph may stand or be captured, promoted pieces may also be there as pawns -- */
+
+	for (Color color : AllColors())
+	{
+		for (const Piece& piece : pieces[color])
+		{
+			const Glyph initial = problem.initialPosition(piece.initialSquare());
+
+			for (Glyph glyph : ValidGlyphs(piece.glyphs()))
+			{
+				const Piece *personality = piece.piece(glyph);
+				if (!personality)
+					continue;
+
+				m_stops[glyph] |= personality->stops();
+				m_stops[initial] |= personality->stops();
+
+				if (maybe(piece.captured()))
+				{
+					m_captures[glyph] |= personality->squares() | piece.squares();
+					m_captures[initial] |= personality->squares() | piece.squares();
+				}
+			}
+		}
+	}
+
+	/* -- Number of pawns in initial position -- */
+
+	for (Color color : AllColors())
+		m_pawns[color] = int(xstd::count(problem.initialPosition(), (color == White) ? WhitePawn : BlackPawn));
+
+	/* -- Retract moves from diagram position, one half move at a time, as long as positions fit in memory -- */
+
+	std::vector<HashPosition> positions(1, HashPosition(problem.diagramPosition()));
+	size_t retracted = 0;
+
+	for (int moves = 1; moves < problem.moves(); moves++)
+	{
+		const int move = problem.moves() - moves;
+		const Color color = (move % 2) ? !problem.turn() : problem.turn();
+
+		std::vector<HashPosition> predecessors;
+		for (const HashPosition& position : positions)
+		{
+			Board board;
+			for (Square square : AllSquares())
+				board[square] = position.glyph(square);
+
+			retract(board, color, &predecessors);
+
+			/* -- Give up if there are too many positions, even when removing duplicates -- */
+
+			if (predecessors.size() * sizeof(HashPosition) > memory)
+			{
+				std::sort(predecessors.begin(), predecessors.end());
+				predecessors.erase(std::unique(predecessors.begin(), predecessors.end()), predecessors.end());
+
+				if (predecessors.size() * sizeof(HashPosition) > memory / 2)
+					return;
+			}
+		}
+
+		std::sort(predecessors.begin(), predecessors.end());
+		predecessors.erase(std::unique(predecessors.begin(), predecessors.end()), predecessors.end());
+
+		/* -- Keep only hash values of these positions for lookups -- */
+
+		std::vector<uint64_t> layer;
+		layer.reserve(predecessors.size());
+		for (const HashPosition& position : predecessors)
+			layer.push_back(position.hash());
+
+		std::sort(layer.begin(), layer.end());
+		layer.erase(std::unique(layer.begin(), layer.end()), layer.end());
+
+		m_layers.push_back(std::move(layer));
+
+		/* -- Stop if diagram position can not be reached, or if next layer is not expected to fit in memory -- */
+
+		const size_t growth = (predecessors.size() + positions.size() - 1) / positions.size();
+		positions.swap(predecessors);
+		retracted += positions.size();
+
+		if (positions.empty() || ((retracted + positions.size() * growth) * sizeof(HashPosition) > memory))
+			break;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Frontier::contains(const HashPosition& position, int moves) const
+{
+	/* -- We do not know anything about positions too far from the diagram position -- */
+
+	if ((moves <= 0) || (moves > depth()))
+		return true;
+
+	const std::vector<uint64_t>& layer = m_layers[moves - 1];
+	return std::binary_search(layer.begin(), layer.end(), position.hash());
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Frontier::retract(const Board& board, Color color, std::vector<HashPosition> *positions) const
+{
+	const Squares occupied([&](Square square) { return board[square] != Empty; });
+	const Glyph pawn = (color == White) ? WhitePawn : BlackPawn;
+	const Glyph king = (color == White) ? WhiteKing : BlackKing;
+	const Glyph rook = (color == White) ? WhiteRook : BlackRook;
+
+	/* -- There can not be more pieces, or more pawns, than in the initial position -- */
+
+	array<int, NumColors> pieces, pawns;
+	for (Color side : AllColors())
+	{
+		pieces[side] = int(xstd::count_if(board, [&](Glyph glyph) { return Euclide::color(glyph) == side; }));
+		pawns[side] = int(xstd::count(board, (side == White) ? WhitePawn : BlackPawn));
+	}
+
+	const bool promotions = (pawns[color] < m_pawns[color]);
+	const bool captures = (pieces[!color] < m_problem.initialPieces(!color));
+	const bool pawnCaptures = captures && (pawns[!color] < m_pawns[!color]);
+
+	/* -- Retract each of our pieces -- */
+
+	for (Square to : ValidSquares(occupied))
+	{
+		const Glyph glyph = board[to];
+		if (Euclide::color(glyph) != color)
+			continue;
+
+		/* -- Piece on last row may have been a pawn -- */
+
+		const Glyphs glyphs = (promotions && PromotionSquares[color][to] && PromotionGlyphs[color][glyph]) ? Glyphs(glyph) | Glyphs(pawn) : Glyphs(glyph);
+
+		for (Glyph moved : ValidGlyphs(glyphs))
+		{
+			for (Square from : ValidSquares(m_rmoves[moved][to] - occupied))
+			{
+				if (!m_stops[moved][from])
+					continue;
+
+				Board before = board;
+				before[to] = Empty;
+				before[from] = moved;
+
+				const Squares position = (occupied - Squares(to)) | Squares(from);
+
+				/* -- Quiet move -- */
+
+				if (!m_rxmoves[moved][to][from] && !(position & (*m_constraints[moved])[from][to]))
+					add(before, color, positions);
+
+				/* -- Capture, of any piece that may be captured on that square -- */
+
+				if (captures && !(position & (*m_xconstraints[moved])[from][to]))
+				{
+					for (Glyph captured : MostGlyphs())
+					{
+						if ((Euclide::color(captured) == color) || (captured == WhiteKing) || (captured == BlackKing) || !m_captures[captured][to])
+							continue;
+
+						if ((captured == WhitePawn) || (captured == BlackPawn))
+							if (!pawnCaptures || (PromotionSquares[White] | PromotionSquares[Black])[to])
+								continue;
+
+						before[to] = captured;
+						add(before, color, positions);
+						before[to] = Empty;
+					}
+				}
+
+				/* -- En passant capture -- */
+
+				if (pawnCaptures && m_problem.enpassant(moved) && m_rxmoves[moved][to][from] && (row(to) == ((color == White) ? 5 : 2)))
+				{
+					const Square where = square(col(to), row(from));
+					const Glyph captured = (color == White) ? BlackPawn : WhitePawn;
+
+					if (!occupied[where] && m_captures[captured][where] && !((position | Squares(where)) & (*m_xconstraints[moved])[from][to]))
+					{
+						before[where] = captured;
+						add(before, color, positions);
+					}
+				}
+			}
+		}
+
+		/* -- Castling -- */
+
+		if (glyph == king)
+		{
+			for (CastlingSide side : AllCastlingSides())
+			{
+				const Castling& castling = Castlings[color][side];
+				if ((to != castling.to) || !m_problem.castling(color, side))
+					continue;
+
+				if ((board[castling.free] != rook) || occupied[castling.from] || occupied[castling.rook])
+					continue;
+
+				Board before = board;
+				before[castling.to] = Empty;
+				before[castling.free] = Empty;
+				before[castling.from] = king;
+				before[castling.rook] = rook;
+
+				add(before, color, positions);
+			}
+		}
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Frontier::add(const Board& board, Color color, std::vector<HashPosition> *positions) const
+{
+	/* -- Side that played the previous move can not be in check -- */
+
+	if (checked(board, !color))
+		return;
+
+	positions->push_back(HashPosition(board));
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Frontier::checked(const Board& board, Color color) const
+{
+	const Glyph king = (color == White) ? WhiteKing : BlackKing;
+	const Square square = Square(std::find(board.begin(), board.end(), king) - board.begin());
+	if (square >= NumSquares)
+		return false;
+
+	const Squares occupied([&](Square square) { return board[square] != Empty; });
+
+	for (Square from : ValidSquares(occupied))
+	{
+		const Glyph glyph = board[from];
+		if (Euclide::color(glyph) == color)
+			continue;
+
+		if (m_checks[glyph][from][square] && !(occupied & (*m_xconstraints[glyph])[from][square]))
+			return true;
+	}
+
+	return false;
+}
+
+/* -------------------------------------------------------------------------- */
+
+}
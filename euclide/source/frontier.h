@@ -0,0 +1,55 @@
+#ifndef __EUCLIDE_FRONTIER_H
+#define __EUCLIDE_FRONTIER_H
+
+#include "includes.h"
+#include "hashtables.h"
+
+namespace Euclide
+{
+
+class Problem;
+class Pieces;
+
+/* -------------------------------------------------------------------------- */
+/* -- Frontier                                                             -- */
+/* -------------------------------------------------------------------------- */
+
+class Frontier
+{
+	public:
+		Frontier(const Problem& problem, const array<Pieces, NumColors>& pieces, size_t memory);
+
+		bool contains(const HashPosition& position, int moves) const;
+
+		inline int depth() const
+			{ return int(m_layers.size()); }
+
+	protected:
+		typedef array<Glyph, NumSquares> Board;
+
+		void retract(const Board& board, Color color, std::vector<HashPosition> *positions) const;
+		void add(const Board& board, Color color, std::vector<HashPosition> *positions) const;
+
+		bool checked(const Board& board, Color color) const;
+
+	private:
+		const Problem& m_problem;                                    /**< Problem to solve. */
+
+		array<ArrayOfSquares, NumGlyphs> m_rmoves;                   /**< Departure squares of legal moves, for each arrival square. */
+		array<ArrayOfSquares, NumGlyphs> m_rxmoves;                  /**< Same as above, for moves that must be captures. */
+		array<const MatrixOfSquares *, NumGlyphs> m_constraints;     /**< Move constraints. */
+		array<const MatrixOfSquares *, NumGlyphs> m_xconstraints;    /**< Capture move constraints. */
+		array<ArrayOfSquares, NumGlyphs> m_checks;                   /**< Legal captures, for checks. */
+
+		array<Squares, NumGlyphs> m_stops;                           /**< Squares on which each glyph may stand, according to deductions. */
+		array<Squares, NumGlyphs> m_captures;                        /**< Squares on which each glyph may be captured, according to deductions. */
+		array<int, NumColors> m_pawns;                               /**< Number of pawns in initial position. */
+
+		std::vector<std::vector<uint64_t>> m_layers;                 /**< Sorted hash values of positions leading to the diagram, for each number of moves left. */
+};
+
+/* -------------------------------------------------------------------------- */
+
+}
+
+#endif
@@ -1,4 +1,5 @@
 #include "game.h"
+#include "frontier.h"
 #include "pieces.h"
 #include "problem.h"
 #include "actions.h"
@@ -11,8 +12,66 @@ namespace Euclide
 /* -- Game                                                                 -- */
 /* -------------------------------------------------------------------------- */
 
-Game::Game(const EUCLIDE_Options& options, const EUCLIDE_Callbacks& callbacks, const Problem& problem, const array<Pieces, NumColors>& pieces, const array<int, NumColors>& freeMoves)
-	: m_options(options), m_callbacks(callbacks), m_problem(problem), m_pieces(pieces), m_hash(problem), m_state(problem), m_cache(16 * 1024 * 1024)
+static inline int64_t saturated(int64_t count, int64_t extra)
+{
+	/* -- Add solution counts, without overflowing -- */
+
+	return (extra > std::numeric_limits<int64_t>::max() - count) ? std::numeric_limits<int64_t>::max() : count + extra;
+}
+
+/* -------------------------------------------------------------------------- */
+
+inline Game::PieceState& Game::pieceState(const Piece& piece)
+{
+	return m_pieceStates[piece.color()][piece.man()][piece.glyph()];
+}
+
+/* -------------------------------------------------------------------------- */
+
+inline const Game::PieceState& Game::pieceState(const Piece& piece) const
+{
+	return m_pieceStates[piece.color()][piece.man()][piece.glyph()];
+}
+
+/* -------------------------------------------------------------------------- */
+
+inline void Game::assign(int *assignedMoves, int *freeMoves, int extraMoves)
+{
+	*assignedMoves += extraMoves;
+	*freeMoves -= extraMoves;
+
+	m_assignments.push({ assignedMoves, freeMoves, extraMoves });
+}
+
+/* -------------------------------------------------------------------------- */
+
+inline void Game::rollback(size_t assignments)
+{
+	/* -- Undo assignments performed since given stack marker, most recent first -- */
+
+	while (m_assignments.size() > assignments)
+	{
+		const Assignment& assignment = m_assignments.back();
+		*assignment.assignedMoves -= assignment.extraMoves;
+		*assignment.freeMoves += assignment.extraMoves;
+
+		m_assignments.pop();
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+inline bool Game::cachable(int moves) const
+{
+	/* -- Positions too close to the initial or diagram positions are cheap to explore again -- */
+
+	return (moves >= 4) && (moves <= m_problem.moves() - 4);
+}
+
+/* -------------------------------------------------------------------------- */
+
+Game::Game(const EUCLIDE_Options& options, const EUCLIDE_Callbacks& callbacks, const Problem& problem, const array<Pieces, NumColors>& pieces, const Tandems& tandems, const array<int, NumColors>& freeMoves)
+	: m_options(options), m_callbacks(callbacks), m_problem(problem), m_pieces(pieces), m_hash(problem), m_state(problem), m_cache(std::make_shared<HashTable>(size_t((options.hashTableSize > 0) ? options.hashTableSize : DefaultHashTableSize) << 20))
 {
 	/* -- Initialize constant tables -- */
 
@@ -20,7 +79,7 @@ Game::Game(const EUCLIDE_Options& options, const EUCLIDE_Callbacks& callbacks, c
 		Tables::initializeLegalMoves(&m_captures[glyph], problem.piece(glyph), color(glyph), problem.variant(), true, true);
 
 	for (Glyph glyph : AllGlyphs())
-		m_constraints[glyph] = *Tables::getMoveConstraints(problem.piece(glyph), problem.variant(), true, false);
+		m_constraints[glyph] = Tables::getMoveConstraints(problem.piece(glyph), problem.variant(), true, false);
 
 	Tables::initializeLineOfSights(problem.pieces(), problem.variant(), &m_lines);
 
@@ -45,22 +104,109 @@ Game::Game(const EUCLIDE_Options& options, const EUCLIDE_Callbacks& callbacks, c
 	{
 		for (const Piece& piece : m_pieces[color])
 		{
-			piece.state.glyph = problem.initialPosition(piece.initialSquare());
-			piece.state.square = piece.initialSquare();
-			piece.state.moves = 0;
+			pieceState(piece).glyph = problem.initialPosition(piece.initialSquare());
+			pieceState(piece).square = piece.initialSquare();
+			pieceState(piece).moves = 0;
 
-			piece.state.assignedMoves = piece.requiredMoves();
+			pieceState(piece).assignedMoves = piece.requiredMoves();
 		}
 	}
 
-	/* -- Initialize free moves -- */
+	/* -- Initialize free moves, and pairs of pieces that will require some of them -- */
 
 	m_moves = freeMoves;
 
+	for (const Tandem& tandem : tandems)
+		if (!maybe(tandem.pieceA.promoted()) && !maybe(tandem.pieceB.promoted()))
+			m_tandems.push_back({ &tandem.pieceA, &tandem.pieceB, tandem.requiredMoves });
+
+	for (Color color : AllColors())
+		for (Detour& detour : m_detours[color])
+			detour.piece = nullptr;
+
+	/* -- Compute positions from which the diagram position can be reached in a few moves -- */
+
+	m_frontier = std::make_shared<Frontier>(problem, pieces, m_cache->memory() / 16);
+
+	/* -- Initialize move ordering statistics -- */
+
+	for (Color color : AllColors())
+		m_history[color].fill(0);
+
+	m_killers.fill({ Nowhere, Nowhere, Empty });
+	m_reached = 0;
+
 	/* -- Initialize solution/position counters -- */
 
 	m_positions = 0;
+	m_reported = 0;
 	m_solutions = 0;
+	m_count = 0;
+	m_reportedCount = 0;
+	m_deferred = 0;
+	m_rejections = 0;
+
+	/* -- Initialize multi-threaded search -- */
+
+	m_master = this;
+	m_threads = std::max(options.numThreads, 0);
+	m_split = 0;
+
+	m_idle = 0;
+	m_aborted = false;
+	m_status = Ok;
+}
+
+/* -------------------------------------------------------------------------- */
+
+Game::Game(Game& master)
+	: m_options(master.m_options), m_callbacks(master.m_callbacks), m_problem(master.m_problem), m_pieces(master.m_pieces), m_tandems(master.m_tandems), m_hash(master.m_hash), m_state(master.m_state), m_cache(master.m_cache), m_frontier(master.m_frontier)
+{
+	/* -- Copy constant tables -- */
+
+	m_captures = master.m_captures;
+	m_constraints = master.m_constraints;
+	m_lines = master.m_lines;
+
+	/* -- Copy position, which is the initial position -- */
+
+	m_board = master.m_board;
+	m_position = master.m_position;
+	m_kings = master.m_kings;
+	m_diagram = master.m_diagram;
+
+	m_pieceStates = master.m_pieceStates;
+	m_moves = master.m_moves;
+
+	for (Color color : AllColors())
+		for (Detour& detour : m_detours[color])
+			detour.piece = nullptr;
+
+	/* -- Initialize worker -- */
+
+	m_exhaustive = master.m_exhaustive;
+
+	for (Color color : AllColors())
+		m_history[color].fill(0);
+
+	m_killers.fill({ Nowhere, Nowhere, Empty });
+	m_reached = 0;
+
+	m_positions = 0;
+	m_reported = 0;
+	m_solutions = 0;
+	m_count = 0;
+	m_reportedCount = 0;
+	m_deferred = 0;
+	m_rejections = 0;
+
+	m_master = &master;
+	m_threads = 0;
+	m_split = 0;
+
+	m_idle = 0;
+	m_aborted = false;
+	m_status = Ok;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -73,7 +219,7 @@ Game::~Game()
 
 void Game::play()
 {
-	m_exhaustive = !m_options.solvingContest;
+	m_exhaustive = !m_options.solvingContest || m_options.countSolutions;
 
 	/* -- Display searching message -- */
 
@@ -82,7 +228,7 @@ void Game::play()
 
 	/* -- Recursively play all moves from initial state -- */
 
-	play(m_state);
+	search();
 
 	/* -- Clear solving contest mode to find all solutions -- */
 
@@ -93,43 +239,163 @@ void Game::play()
 		if (m_callbacks.displayMessage)
 			(*m_callbacks.displayMessage)(m_callbacks.handle, EUCLIDE_MESSAGE_EXHAUSTING);
 
-		m_cache.reset();
-		play(m_state);
+		/* -- Cached positions are kept, except those that only lead nowhere because of rejected dualistic move orders -- */
+
+		search();
 	}
 
 	/* -- Done -- */
 
 	EUCLIDE_Thinking thinking;
-	thinking.positions = m_positions;
+	report(&thinking);
 	thinking.numHalfMoves = 0;
 
 	if (m_callbacks.displayThinking)
 		(*m_callbacks.displayThinking)(m_callbacks.handle, &thinking);
 
-	if (!m_solutions)
+	if (!m_solutions && !m_count)
 		throw NoSolution;
 }
 
 /* -------------------------------------------------------------------------- */
 
+void Game::search()
+{
+	/* -- Single threaded search -- */
+
+	if ((m_threads <= 1) || (m_problem.moves() < 2))
+	{
+		play(m_state);
+		return;
+	}
+
+	/* -- Split search tree into enough tasks to keep all workers busy -- */
+
+	const int64_t positions = m_positions;
+	for (m_split = 1; int(m_split) < m_problem.moves(); m_split++)
+	{
+		m_tasks.clear();
+		m_positions = positions;
+
+		play(m_state);
+
+		if (m_tasks.empty() || (m_tasks.size() >= 16 * size_t(m_threads)))
+			break;
+	}
+
+	m_split = 0;
+
+	/* -- Let workers explore these tasks, and the ones they donate -- */
+
+	m_idle = 0;
+	m_aborted = false;
+	m_status = Ok;
+
+	std::vector<std::unique_ptr<Game>> workers;
+	for (int k = 0; k < m_threads; k++)
+		workers.emplace_back(new Game(*this));
+
+	std::vector<std::thread> threads;
+	for (std::unique_ptr<Game>& worker : workers)
+		threads.emplace_back(&Game::work, worker.get());
+
+	for (std::thread& thread : threads)
+		thread.join();
+
+	m_tasks.clear();
+
+	/* -- Forward status of first worker that stopped the search -- */
+
+	if (m_aborted)
+		throw m_status;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Game::work()
+{
+	/* -- Explore tasks until there are none left -- */
+
+	try
+	{
+		while (m_master->task(&m_path))
+			play(m_state);
+	}
+	catch (Status status)
+	{
+		m_master->abort(status);
+	}
+	catch (std::bad_alloc&)
+	{
+		m_master->abort(OutOfMemory);
+	}
+
+	/* -- Report number of positions examined -- */
+
+	auto lock = this->lock();
+	report(nullptr);
+}
+
+/* -------------------------------------------------------------------------- */
+
 bool Game::play(const State& _state)
 {
-	m_positions += 1;
+	/* -- Record subtree as a task if we are splitting the search tree -- */
+
+	if (m_split && (m_states.size() >= m_split))
+	{
+		m_tasks.push_back(path());
+		m_deferred += 1;
+		return true;
+	}
 
-	/* -- Early exit if position is in cache -- */
+	/* -- Count position, unless we are replaying moves leading to our task -- */
+
+	const Move *replay = (m_states.size() < m_path.size()) ? &m_path[m_states.size()] : nullptr;
+	if (!replay)
+		m_positions += 1;
+
+	/* -- Keep track of how deep we went, for move ordering -- */
+
+	m_reached = std::max<unsigned>(m_reached, m_states.size());
+
+	/* -- Early exit if position is in cache, which also tells how many solutions it leads to when counting them -- */
+
+	if (cachable(m_states.size()) && !(m_options.countSolutions && replay))
+	{
+		HashTable::Outcome outcome;
+		if (m_cache->contains(m_hash, m_states.size(), !m_exhaustive, &outcome, &m_statistics))
+		{
+			m_count = saturated(m_count, outcome.solutions);
+			m_rejections += outcome.contest ? 1 : 0;
+			return outcome.solutions > 0;
+		}
+	}
 
-	auto cachable = [&](int moves) { return (moves >= 4) && (moves <= m_problem.moves() - 4); };
+	/* -- Early exit if diagram position can not be reached from this position -- */
 
-	if (cachable(m_states.size()) && !_state.enpassant())
-		if (m_cache.contains(m_hash, m_states.size()))
+	if (m_problem.moves() - int(m_states.size()) <= m_frontier->depth())
+		if (!m_frontier->contains(m_hash.board(), m_problem.moves() - m_states.size()))
 			return false;
 
+	/* -- Early exit if some pieces have to go around pieces that will not move anymore, and can not afford it -- */
+
+	if (blocked())
+		return false;
+
+	/* -- Early exit if pairs of pieces obstructing each other need more moves than there are left -- */
+
+	if (tandems())
+		return false;
+
 	/* -- Thinking callback -- */
 
 	if ((m_states.size() == countof(EUCLIDE_Thinking::moves)) || (m_positions % (1024 * 1024) == 0))
 	{
+		auto lock = this->lock();
+
 		EUCLIDE_Thinking thinking;
-		thinking.positions = m_positions;
+		report(&thinking);
 		cmoves(thinking.moves, thinking.numHalfMoves = std::min<int>(countof(EUCLIDE_Thinking::moves), m_states.size()));
 
 		if (m_callbacks.displayThinking)
@@ -140,6 +406,11 @@ bool Game::play(const State& _state)
 		if (m_callbacks.abort)
 			if ((*m_callbacks.abort)(m_callbacks.handle))
 				throw UserAborted;
+
+		/* -- Check if another worker has stopped the search -- */
+
+		if (m_master->m_aborted)
+			throw m_master->m_status;
 	}
 
 	/* -- End recursion -- */
@@ -149,43 +420,21 @@ bool Game::play(const State& _state)
 		/* -- Check for solution -- */
 
 		const bool solved = this->solved();
+		if (solved && m_options.countSolutions)
+		{
+			m_count = saturated(m_count, 1);
+		}
+		else
 		if (solved)
 		{
-			/* -- Thinking callback -- */
-
-			EUCLIDE_Thinking thinking;
-			thinking.positions = m_positions;
-			cmoves(thinking.moves, thinking.numHalfMoves = std::min<int>(countof(EUCLIDE_Thinking::moves), m_states.size()));
-
-			if (m_callbacks.displayThinking)
-				(*m_callbacks.displayThinking)(m_callbacks.handle, &thinking);
-
-			/* -- Solution callback -- */
+			/* -- Report solution -- */
 
-			EUCLIDE_Solution solution;
-			solution.numHalfMoves = m_states.size();
-			cmoves(solution.moves, m_states.size());
-
-			if (!duplicate(solution))
-			{
-				solution.solution = ++m_solutions;
-
-				if (m_callbacks.displaySolution)
-					(*m_callbacks.displaySolution)(m_callbacks.handle, &solution);
-
-				/* -- Store solution if suitable -- */
-
-				if (!m_exhaustive)
-					m_quickies.push_back(solution);
-
-				/* -- Stop searching if we have found many solutions -- */
-
-				if ((m_options.maxSolutions > 0) && (m_solutions >= m_options.maxSolutions))
-					throw Ok;
-			}
+			record();
 
 			/* -- Check for user abort -- */
 
+			auto lock = this->lock();
+
 			if (m_callbacks.abort)
 				if ((*m_callbacks.abort)(m_callbacks.handle))
 					throw UserAborted;
@@ -200,7 +449,7 @@ bool Game::play(const State& _state)
 
 	if (!m_exhaustive && (m_states.size() >= 3))
 	{
-		const State **states = m_states.data() + m_states.size();
+		const State *const *states = m_states.data() + m_states.size();
 		const State *state = (m_states.size() > 3) ? states[-4] : &m_state;
 
 		bool backtrack = true;
@@ -267,7 +516,10 @@ bool Game::play(const State& _state)
 			move(*states[-2], states[-1]->from(), states[-1]->to(), states[-1]->glyph());
 
 			if (dualistic)
+			{
+				m_rejections += 1;
 				return false;
+			}
 		}
 	}
 
@@ -278,98 +530,168 @@ bool Game::play(const State& _state)
 
 	bool solved = false;
 
+	Candidates& candidates = m_candidates[m_states.size()];
+	candidates.clear();
+
 	for (Square from : ValidSquares(m_position[color]))
 	{
+		if (replay && (from != replay->from))
+			continue;
+
 		const Piece& piece = *m_board[from];
-		const Glyph glyph = piece.state.glyph;
-		const bool pawn = (glyph != piece.glyph());
+		const bool pawn = (pieceState(piece).glyph != piece.glyph());
 
 		const Squares destinations = piece.moves(from, pawn) - m_position[color];
 		for (Square to : ValidSquares(destinations))
-		{
-			/* -- Check if capture is ok -- */
+			if (!replay || (to == replay->to))
+				candidates.push_back({ from, to, 0 });
+	}
 
-			const bool enpassant = _state.enpassant(to) && m_problem.enpassant(glyph);
-			const bool capture = m_position[!color][to] || enpassant;
-			const Square where = enpassant ? square(col(to), row(from)) : to;
+	/* -- Try most promising moves first when we only need one solution -- */
 
-			if (capture && !maybe(m_board[where]->captured(where)))
-				continue;
+	const bool ordering = !m_exhaustive || (m_options.maxSolutions == 1);
+	if (ordering && !replay)
+		order(&candidates, color);
 
-			if (!capture && piece.captures(from, pawn)[to])
-				continue;
+	/* -- Play them -- */
+
+	for (const Candidate& candidate : candidates)
+	{
+		const Square from = candidate.from;
+		const Square to = candidate.to;
 
-			/* -- Check if move is possible given other pieces on the board -- */
+		const Piece& piece = *m_board[from];
+		const Glyph glyph = pieceState(piece).glyph;
+		const bool pawn = (glyph != piece.glyph());
 
-			if (position & piece.constraints(from, to, capture, pawn))
-				continue;
+		/* -- Check if capture is ok -- */
 
-			/* -- Check consequences of that move and if there are any free moves left -- */
+		const bool enpassant = _state.enpassant(to) && m_problem.enpassant(glyph);
+		const bool capture = m_position[!color][to] || enpassant;
+		const Square where = enpassant ? square(col(to), row(from)) : to;
 
-			size_t assignments = m_assignments.size();
-			auto cleanup = [&](size_t *assignments) { m_assignments.resize(*assignments); };
-			std::unique_ptr<size_t, decltype(cleanup)> _(&assignments, cleanup);
+		if (capture && !maybe(m_board[where]->captured(where)))
+			continue;
 
-			if (!maybe(piece.promoted()))
+		if (!capture && piece.captures(from, pawn)[to])
+			continue;
+
+		/* -- Check if move is possible given other pieces on the board -- */
+
+		if (position & piece.constraints(from, to, capture, pawn))
+			continue;
+
+		/* -- Check consequences of that move and if there are any free moves left -- */
+
+		const size_t assignments = m_assignments.size();
+
+		if (!maybe(piece.promoted()))
+		{
+			const Consequences& consequences = piece.consequences(from, to);
+			for (const Consequence& consequence : consequences.consequences())
 			{
-				const Consequences& consequences = piece.consequences(from, to);
-				for (const Consequence& consequence : consequences.consequences())
+				const Piece& impacted = consequence.piece();
+				if (&impacted != &piece)
 				{
-					const Piece& impacted = consequence.piece();
-					if (&impacted != &piece)
-					{
-						const int requiredMoves = consequence.requiredMoves(impacted.state.square);
-						const int extraMoves = requiredMoves - impacted.state.assignedMoves;
-						if (extraMoves > 0)
-							m_assignments.emplace_back(&impacted.state.assignedMoves, &m_moves[impacted.color()], extraMoves);
-					}
+					const int requiredMoves = consequence.requiredMoves(pieceState(impacted).square);
+					const int extraMoves = requiredMoves - pieceState(impacted).assignedMoves;
+					if (extraMoves > 0)
+						assign(&pieceState(impacted).assignedMoves, &m_moves[impacted.color()], extraMoves);
 				}
 			}
+		}
+
+		const int requiredMoves = pieceState(piece).moves + 1 + piece.requiredMovesFrom(to, pawn);
+		const int extraMoves = requiredMoves - pieceState(piece).assignedMoves;
+		if (extraMoves > 0)
+			assign(&pieceState(piece).assignedMoves, &m_moves[color], extraMoves);
+
+		if (xstd::any_of(m_moves, [](int freeMoves) { return freeMoves < 0; }))
+		{
+			rollback(assignments);
+			continue;
+		}
 
-			const int requiredMoves = piece.state.moves + 1 + piece.requiredMovesFrom(to, pawn);
-			const int extraMoves = requiredMoves - piece.state.assignedMoves;
-			if (extraMoves > 0)
-				m_assignments.emplace_back(&piece.state.assignedMoves, &m_moves[color], extraMoves);
+		/* -- Handle promotion -- */
 
-			if (xstd::any_of(m_moves, [](int freeMoves) { return freeMoves < 0; }))
+		const bool promotion = piece.promotions()[to] && ((glyph == WhitePawn) || (glyph == BlackPawn));
+		const Glyphs glyphs = promotion ? piece.glyphs() - Glyphs(glyph) : Glyphs(glyph);
+		for (Glyph glyph : ValidGlyphs(glyphs))
+		{
+			if (replay && (glyph != replay->glyph))
 				continue;
 
-			/* -- Handle promotion -- */
+			/* -- Perform move and compute new game state -- */
+
+			State state = move(_state, from, to, glyph);
+			m_states.push(&state);
 
-			const bool promotion = piece.promotions()[to] && ((glyph == WhitePawn) || (glyph == BlackPawn));
-			const Glyphs glyphs = promotion ? piece.glyphs() - Glyphs(glyph) : Glyphs(glyph);
-			for (Glyph glyph : ValidGlyphs(glyphs))
+			/* -- Move may be invalid, if we have put ourself into check -- */
+
+			if (state.valid())
 			{
-				/* -- Perform move and compute new game state -- */
+				const unsigned reached = m_reached;
+				m_reached = 0;
+
+				const int64_t count = m_count;
+				const int64_t deferred = m_deferred;
+				const int64_t rejections = m_rejections;
 
-				State state = move(_state, from, to, glyph);
-				m_states.push_back(&state);
+				/* -- Let idle workers explore subtree, if it is large enough -- */
 
-				/* -- Move may be invalid, if we have put ourself into check -- */
+				const bool donatable = (m_master != this) && (m_states.size() > m_path.size()) && (int(m_states.size()) + 6 < m_problem.moves());
 
-				if (state.valid())
+				if (donatable && (m_master->m_idle > 0) && m_master->donate(path()))
 				{
-					/* -- Recursive call -- */
+					m_deferred += 1;
+					solved = true;
+				}
+				else
 
-					if (!play(state))
-					{
-						/* -- Add position to cache if it does not lead to a solution -- */
+				/* -- Recursive call -- */
 
-						if (cachable(m_states.size()))
-							m_cache.insert(m_hash, m_states.size());
-					}
-					else
-					{
-						solved = true;
-					}
+				if (!play(state))
+				{
+					/* -- Add position to cache if it does not lead to a solution, and if it has been fully explored, noting if dualistic move orders were rejected -- */
+
+					if (cachable(m_states.size()) && (m_states.size() >= m_path.size()))
+						m_cache->insert(m_hash, m_states.size(), HashTable::Outcome(0, m_rejections != rejections), &m_statistics);
+				}
+				else
+				{
+					solved = true;
+
+					/* -- Also add it with its number of solutions when counting them, unless some of its subtrees were left to other workers -- */
+
+					if (m_options.countSolutions && cachable(m_states.size()) && (m_states.size() >= m_path.size()))
+						if ((m_deferred == deferred) && (m_count < std::numeric_limits<int64_t>::max()))
+							m_cache->insert(m_hash, m_states.size(), HashTable::Outcome(m_count - count), &m_statistics);
 				}
 
-				/* -- Undo move -- */
+				/* -- Remember moves that led to long games, to try them first next time -- */
+
+				if (ordering)
+				{
+					const int depth = int(m_reached) - int(m_states.size());
+					if (depth > 0)
+						m_history[color][from][to] = std::min(m_history[color][from][to] + depth * depth, (1 << 20) - 1);
 
-				m_states.pop_back();
-				undo(state);
+					if (int(m_reached) >= m_problem.moves())
+						m_killers[m_states.size() - 1] = { from, to, glyph };
+				}
+
+				m_reached = std::max(m_reached, reached);
 			}
+
+			/* -- Undo move -- */
+
+			m_states.pop();
+			undo(state);
 		}
+
+		/* -- Undo free moves assignments -- */
+
+		rollback(assignments);
 	}
 
 	/* -- Done -- */
@@ -387,7 +709,7 @@ Game::State Game::move(const State& state, Square from, Square to, Glyph glyph)
 	const Square capture = (state.enpassant(to) && m_problem.enpassant(glyph)) ? square(col(to), row(from)) : to;
 	const Piece *captured = m_board[capture];
 
-	const Glyph initial = piece->state.glyph;
+	const Glyph initial = pieceState(*piece).glyph;
 	const Piece *promotion = (glyph != initial) ? piece->piece(glyph) : piece;
 
 	bool valid = true;
@@ -406,10 +728,10 @@ Game::State Game::move(const State& state, Square from, Square to, Glyph glyph)
 			valid = false;
 
 		const Piece *rook = m_board[Castlings[color][castling].rook];
-		if (!rook || (rook->color() != color) || !maybe(rook->castling(castling)) || rook->state.moves)
+		if (!rook || (rook->color() != color) || !maybe(rook->castling(castling)) || pieceState(*rook).moves)
 			valid = false;
 
-		if (state.check() || checked(Castlings[color][castling].free, color))
+		if (state.check() || checked(Castlings[color][castling].free, Castlings[color][castling].free, color))
 			valid = false;
 
 		if (!valid)
@@ -418,6 +740,9 @@ Game::State Game::move(const State& state, Square from, Square to, Glyph glyph)
 
 	/* -- Update board position -- */
 
+	if (state.enpassant())
+		m_hash[state.crossed()] = false;
+
 	m_hash[capture] = Empty;
 	m_hash[to] = glyph;
 	m_hash[from] = Empty;
@@ -438,13 +763,13 @@ Game::State Game::move(const State& state, Square from, Square to, Glyph glyph)
 
 	/* -- Update piece state -- */
 
-	promotion->state.glyph = glyph;
-	promotion->state.square = to;
-	promotion->state.moves = piece->state.moves + 1;
-	promotion->state.assignedMoves = piece->state.assignedMoves;
+	pieceState(*promotion).glyph = glyph;
+	pieceState(*promotion).square = to;
+	pieceState(*promotion).moves = pieceState(*piece).moves + 1;
+	pieceState(*promotion).assignedMoves = pieceState(*piece).assignedMoves;
 
 	if (captured)
-		captured->state.square = Nowhere;
+		pieceState(*captured).square = Nowhere;
 
 	/* -- Handle castling -- */
 
@@ -467,7 +792,7 @@ Game::State Game::move(const State& state, Square from, Square to, Glyph glyph)
 
 		assert(!captured);
 
-		m_board[free]->state.square = free;
+		pieceState(*m_board[free]).square = free;
 	}
 
 	/* -- Update castlings states -- */
@@ -476,7 +801,7 @@ Game::State Game::move(const State& state, Square from, Square to, Glyph glyph)
 	for (CastlingSide side : AllCastlingSides())
 		castlings[side] = state.castling(side) && (m_kings[color] != to) && (m_board[to]->initialSquare() != Castlings[color][side].rook);
 
-	m_hash[m_kings[color]] = castlings;
+	m_hash.castlings(color, m_kings[color], castlings);
 
 	/* -- Update en passant state -- */
 
@@ -485,23 +810,20 @@ Game::State Game::move(const State& state, Square from, Square to, Glyph glyph)
 		if (abs(row(from) - row(to)) == 2)
 			enpassant = Square((from + to) / 2);
 
-	/* -- Check if move is valid -- */
+	if (enpassant != Nowhere)
+		m_hash[enpassant] = true;
 
-	if ((piece->royal() || state.check()) ? checked(m_kings[color], color) : checked(m_kings[color], from, color))
+	/* -- Check if move is valid, our king may only be attacked through vacated squares unless it has moved or was in check -- */
+
+	const Squares vacated = Squares(from) | (Squares(capture) - Squares(to));
+
+	if (checked(m_kings[color], (piece->royal() || state.check()) ? Squares(m_kings[color]) : vacated, color))
 		valid = false;
 
-	/* -- Set check state -- */
+	/* -- Set check state, given by pieces that have moved or through vacated squares -- */
 
-	bool check = false;
-	if (checks(glyph, to, m_kings[!color]))
-		check = true;
-	else
-	if (checked(m_kings[!color], from, !color))
-		check = true;
-	else
-	if (castling != NoCastling)
-		if (checks(m_board[Castlings[color][castling].free]->glyph(), Castlings[color][castling].free, m_kings[!color]))
-			check = true;
+	const Squares moved = (castling != NoCastling) ? Squares(to) | Squares(Castlings[color][castling].free) : Squares(to);
+	const bool check = checked(m_kings[!color], moved | vacated, !color);
 
 	/* -- Return new state -- */
 
@@ -523,6 +845,9 @@ void Game::undo(const State& state)
 
 	/* -- Update board position -- */
 
+	if (state.enpassant())
+		m_hash[state.crossed()] = false;
+
 	m_hash[to] = Empty;
 	m_hash[from] = glyph;
 	if (captured)
@@ -541,13 +866,13 @@ void Game::undo(const State& state)
 
 	/* -- Update piece state -- */
 
-	piece->state.glyph = glyph;
-	piece->state.square = from;
-	piece->state.moves = original->state.moves - 1;
-	assert(piece->state.assignedMoves == original->state.assignedMoves);
+	pieceState(*piece).glyph = glyph;
+	pieceState(*piece).square = from;
+	pieceState(*piece).moves = pieceState(*original).moves - 1;
+	assert(pieceState(*piece).assignedMoves == pieceState(*original).assignedMoves);
 
 	if (captured)
-		captured->state.square = to;
+		pieceState(*captured).square = to;
 
 	/* -- Handle castling -- */
 
@@ -565,40 +890,292 @@ void Game::undo(const State& state)
 		m_position[color][rook] = true;
 		m_position[color][free] = false;
 
-		m_board[rook]->state.square = rook;
+		pieceState(*m_board[rook]).square = rook;
 	}
 
-	m_hash[m_kings[color]] = state.castlings(color);
+	m_hash.castlings(color, m_kings[color], state.castlings(color));
+
+	if (state.expired() != Nowhere)
+		m_hash[state.expired()] = true;
 }
 
 /* -------------------------------------------------------------------------- */
 
-bool Game::checks(Glyph glyph, Square from, Square king) const
+bool Game::blocked()
 {
-	const Squares blockers = m_position[White] | m_position[Black];
+	/* -- Without free moves left, pieces that have played all their assigned moves will not move again -- */
 
-	if (m_captures[glyph][from][king])
-		if (!(m_constraints[glyph][from][king] & blockers))
+	Squares obstructions;
+	for (Color color : AllColors())
+	{
+		if (m_moves[color] > 0)
+			continue;
+
+		for (Square square : ValidSquares(m_position[color]))
+		{
+			const Piece& piece = *m_board[square];
+			const PieceState& state = pieceState(piece);
+
+			if (state.assignedMoves > state.moves)
+				continue;
+
+			/* -- Unless they may be captured, or be a castling rook -- */
+
+			if (maybe(piece.captured()) || xstd::any_of(AllCastlingSides(), [&](CastlingSide side) { return maybe(piece.castling(side)); }))
+				continue;
+
+			obstructions.set(square);
+		}
+	}
+
+	if (!obstructions)
+		return false;
+
+	/* -- Other pieces may have to go around them, which requires moves that may not have been assigned yet -- */
+
+	array<int, NumColors> extraMoves = {{ 0, 0 }};
+	for (Color color : AllColors())
+	{
+		for (Square square : ValidSquares(m_position[color] - obstructions))
+		{
+			const Piece& piece = *m_board[square];
+			const PieceState& state = pieceState(piece);
+
+			if (maybe(piece.promoted()) || (state.glyph != piece.glyph()) || !piece.requiredMovesFrom(square))
+				continue;
+
+			const int requiredMoves = state.moves + distance(piece, square, obstructions);
+			if (requiredMoves > state.assignedMoves)
+				if ((extraMoves[color] += requiredMoves - state.assignedMoves) > m_moves[color])
+					return true;
+		}
+	}
+
+	return false;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Game::tandems() const
+{
+	for (const Pair& tandem : m_tandems)
+	{
+		const Color colorA = tandem.pieceA->color();
+		const Color colorB = tandem.pieceB->color();
+
+		/* -- Moves required by both pieces that have not yet been assigned to either of them -- */
+
+		const int extraMoves = tandem.requiredMoves - pieceState(*tandem.pieceA).assignedMoves - pieceState(*tandem.pieceB).assignedMoves;
+		if (extraMoves <= 0)
+			continue;
+
+		/* -- They must be played by one of the two pieces, using free moves -- */
+
+		if (extraMoves > ((colorA == colorB) ? m_moves[colorA] : m_moves[colorA] + m_moves[colorB]))
 			return true;
+	}
 
 	return false;
 }
 
 /* -------------------------------------------------------------------------- */
 
-bool Game::checked(Square king, Color color) const
+int Game::distance(const Piece& piece, Square square, Squares obstructions)
 {
-	return checked(king, king, color);
+	/* -- Obstructions seldom change from one position to the next, so keep last distance computed -- */
+
+	Detour& detour = m_detours[piece.color()][piece.man()];
+	if ((detour.piece != &piece) || (detour.square != square) || (detour.obstructions != obstructions))
+	{
+		detour.piece = &piece;
+		detour.square = square;
+		detour.obstructions = obstructions;
+		detour.distance = piece.requiredMovesAround(square, obstructions);
+	}
+
+	return detour.distance;
 }
 
 /* -------------------------------------------------------------------------- */
 
-bool Game::checked(Square king, Square free, Color color) const
+bool Game::playable(const State& state, const Move& move) const
 {
-	const Squares enemies = m_lines[color][king][free] & m_position[!color];
+	const Piece *piece = m_board[move.from];
+	const Color color = state.color();
+
+	if (!piece || (piece->color() != color) || m_position[color][move.to])
+		return false;
+
+	const Glyph glyph = pieceState(*piece).glyph;
+	const bool pawn = (glyph != piece->glyph());
+
+	if (!piece->moves(move.from, pawn)[move.to])
+		return false;
+
+	/* -- Check captures as when searching -- */
+
+	const bool enpassant = state.enpassant(move.to) && m_problem.enpassant(glyph);
+	const bool capture = m_position[!color][move.to] || enpassant;
+	const Square where = enpassant ? square(col(move.to), row(move.from)) : move.to;
+
+	if (capture && !maybe(m_board[where]->captured(where)))
+		return false;
+
+	if (!capture && piece->captures(move.from, pawn)[move.to])
+		return false;
+
+	/* -- Check obstructions and promotion -- */
+
+	if ((m_position[White] | m_position[Black]) & piece->constraints(move.from, move.to, capture, pawn))
+		return false;
+
+	if (move.glyph != glyph)
+		if (!piece->promotions()[move.to] || ((glyph != WhitePawn) && (glyph != BlackPawn)) || !piece->glyphs()[move.glyph])
+			return false;
+
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Game::rewind(States *states)
+{
+	/* -- Take back all moves, keeping game states to restore them later -- */
+
+	std::copy(m_states.begin(), m_states.end(), states->begin());
+
+	while (!m_states.empty())
+	{
+		undo(*m_states.back());
+		m_states.pop();
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Game::restore(const States& states, const Path& path)
+{
+	for (size_t k = 0; k < path.size(); k++)
+	{
+		move(k ? *states[k - 1] : m_state, path[k].from, path[k].to, path[k].glyph);
+		m_states.push(states[k]);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+Game::Path Game::group(const Path& path)
+{
+	/* -- Solutions with the same moves for each side, in any order, share the same group -- */
+
+	Path group = path;
+	for (size_t side = 0; side < 2; side++)
+	{
+		Path moves;
+		for (size_t k = side; k < group.size(); k += 2)
+			moves.push_back(group[k]);
+
+		std::sort(moves.begin(), moves.end());
+
+		for (size_t k = side; k < group.size(); k += 2)
+			group[k] = moves[k / 2];
+	}
+
+	return group;
+}
+
+/* -------------------------------------------------------------------------- */
+
+int64_t Game::orders(const Path& path)
+{
+	States states;
+	rewind(&states);
+
+	/* -- Count legal orders of given moves that reach the diagram position, without enumerating them -- */
+
+	Played played = {};
+	std::map<std::pair<Played, HashPosition>, int64_t> counts;
+	const int64_t orders = this->orders(path, played, counts);
+
+	restore(states, path);
+	return orders;
+}
+
+/* -------------------------------------------------------------------------- */
 
-	for (Square from : ValidSquares(enemies))
-		if (checks(m_board[from]->state.glyph, from, king))
+int64_t Game::orders(const Path& path, Played& played, std::map<std::pair<Played, HashPosition>, int64_t>& counts)
+{
+	if (m_states.size() >= path.size())
+		return solved() ? 1 : 0;
+
+	/* -- Positions reached by playing the same moves in different orders are only explored once -- */
+
+	const std::pair<Played, HashPosition> key(played, m_hash);
+	const auto found = counts.find(key);
+	if (found != counts.end())
+		return found->second;
+
+	/* -- Try each move left for the side to move, only once when the same move is played several times -- */
+
+	const State& state = m_states.empty() ? m_state : *m_states.back();
+	int64_t orders = 0;
+
+	for (size_t k = m_states.size() & 1; k < path.size(); k += 2)
+	{
+		if ((played[k / 64] >> (k % 64)) & 1)
+			continue;
+
+		bool repeated = false;
+		for (size_t j = k & 1; (j < k) && !repeated; j += 2)
+			if (!((played[j / 64] >> (j % 64)) & 1) && (path[j] == path[k]))
+				repeated = true;
+
+		if (repeated || !playable(state, path[k]))
+			continue;
+
+		State next = move(state, path[k].from, path[k].to, path[k].glyph);
+		m_states.push(&next);
+
+		if (next.valid())
+		{
+			played[k / 64] ^= uint64_t(1) << (k % 64);
+			orders = saturated(orders, this->orders(path, played, counts));
+			played[k / 64] ^= uint64_t(1) << (k % 64);
+		}
+
+		m_states.pop();
+		undo(next);
+	}
+
+	counts[key] = orders;
+	return orders;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Game::checks(Glyph glyph, Square from, Square king) const
+{
+	const Squares blockers = m_position[White] | m_position[Black];
+
+	if (m_captures[glyph][from][king])
+		if (!((*m_constraints[glyph])[from][king] & blockers))
+			return true;
+
+	return false;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Game::checked(Square king, Squares squares, Color color) const
+{
+	/* -- Only enemy pieces on given squares, or with a line of sight to our king through them, may give check -- */
+
+	Squares enemies = squares;
+	for (Square square : ValidSquares(squares))
+		enemies |= m_lines[color][king][square];
+
+	for (Square from : ValidSquares(enemies & m_position[!color]))
+		if (checks(pieceState(*m_board[from]).glyph, from, king))
 			return true;
 
 	return false;
@@ -620,7 +1197,7 @@ bool Game::solved() const
 	/* -- Check all pieces -- */
 
 	for (Square square : ValidSquares(m_diagram))
-		if (m_board[square]->state.glyph != m_problem.diagramPosition(square))
+		if (pieceState(*m_board[square]).glyph != m_problem.diagramPosition(square))
 			return false;
 
 	/* -- Solution found -- */
@@ -630,9 +1207,95 @@ bool Game::solved() const
 
 /* -------------------------------------------------------------------------- */
 
+void Game::record()
+{
+	/* -- Report solution given by current game states, lock must not be held -- */
+
+	int orders = 1;
+	Path grouped;
+
+	/* -- Solutions only differing by move order are reported once, when grouping them -- */
+
+	if (m_options.groupSolutions)
+	{
+		const Path path = this->path();
+		grouped = group(path);
+
+		{
+			auto lock = this->lock();
+			if (stopped() || m_master->m_groups.count(grouped))
+				return;
+		}
+
+		/* -- Move orders are counted without holding the lock, as it may take a while -- */
+
+		orders = int(std::min<int64_t>(this->orders(path), std::numeric_limits<int>::max()));
+	}
+
+	auto lock = this->lock();
+
+	if (stopped())
+		return;
+
+	if (m_options.groupSolutions)
+		if (!m_master->m_groups.insert(grouped).second)
+			return;
+
+	/* -- Thinking callback -- */
+
+	EUCLIDE_Thinking thinking;
+	report(&thinking);
+	cmoves(thinking.moves, thinking.numHalfMoves = std::min<int>(countof(EUCLIDE_Thinking::moves), m_states.size()));
+
+	if (m_callbacks.displayThinking)
+		(*m_callbacks.displayThinking)(m_callbacks.handle, &thinking);
+
+	/* -- Solution callback -- */
+
+	EUCLIDE_Solution solution;
+	solution.numHalfMoves = m_states.size();
+	solution.numOrders = orders;
+	cmoves(solution.moves, m_states.size());
+
+	if (!duplicate(solution))
+	{
+		solution.solution = ++m_master->m_solutions;
+
+		if (m_callbacks.displaySolution)
+			(*m_callbacks.displaySolution)(m_callbacks.handle, &solution);
+
+		/* -- Store solution if suitable -- */
+
+		if (!m_exhaustive)
+			m_master->m_quickies.push_back(solution);
+
+		/* -- Stop searching if we have found many solutions -- */
+
+		if ((m_options.maxSolutions > 0) && (m_master->m_solutions >= m_options.maxSolutions))
+			throw Ok;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Game::stopped() const
+{
+	/* -- Workers waiting for the lock must not report solutions once the search has been stopped, lock must be held -- */
+
+	if (m_master->m_aborted)
+		return true;
+
+	if ((m_options.maxSolutions > 0) && (m_master->m_solutions >= m_options.maxSolutions))
+		return true;
+
+	return false;
+}
+
+/* -------------------------------------------------------------------------- */
+
 bool Game::duplicate(const EUCLIDE_Solution& solution) const
 {
-	return xstd::any_of(m_quickies, [&](const EUCLIDE_Solution& quicky) {
+	return xstd::any_of(m_master->m_quickies, [&](const EUCLIDE_Solution& quicky) {
 		return std::equal(solution.moves, solution.moves + solution.numHalfMoves, quicky.moves, [](const EUCLIDE_Move& lhs, const EUCLIDE_Move& rhs) {
 			return (lhs.from == rhs.from) && (lhs.to == rhs.to) && (lhs.promotion == rhs.promotion);
 		});
@@ -686,6 +1349,170 @@ void Game::cmoves(EUCLIDE_Move *moves, int nmoves) const
 	}
 }
 
+/* -------------------------------------------------------------------------- */
+
+void Game::order(Candidates *candidates, Color color) const
+{
+	const Move& killer = m_killers[m_states.size()];
+
+	for (Candidate& candidate : *candidates)
+	{
+		const Piece& piece = *m_board[candidate.from];
+		const bool pawn = (pieceState(piece).glyph != piece.glyph());
+
+		/* -- Moves bringing the piece closer to its destination first -- */
+
+		const int detour = 1 + piece.requiredMovesFrom(candidate.to, pawn) - piece.requiredMovesFrom(candidate.from, pawn);
+		int score = -16 * std::max(0, std::min(detour, 8));
+
+		/* -- Moves that have to be played anyway, and that do not require extra moves from other pieces -- */
+
+		if (!maybe(piece.promoted()))
+		{
+			const Action& action = piece.actions().get(candidate.from, candidate.to);
+			score += action.mandatory() ? 8 : 0;
+			score += action.unique() ? 2 : 0;
+
+			for (const Consequence& consequence : action.consequences().consequences())
+			{
+				const Piece& impacted = consequence.piece();
+				if (&impacted != &piece)
+					score -= 4 * std::max(0, std::min(consequence.requiredMoves(pieceState(impacted).square) - pieceState(impacted).assignedMoves, 8));
+			}
+		}
+
+		/* -- Then moves that led to long games elsewhere in the search tree -- */
+
+		const bool killed = (candidate.from == killer.from) && (candidate.to == killer.to);
+		candidate.score = std::max(score, -512) * (1 << 21) + (killed ? (1 << 20) : 0) + m_history[color][candidate.from][candidate.to];
+	}
+
+	/* -- Sort by decreasing score, keeping square order for equal scores -- */
+
+	std::sort(candidates->begin(), candidates->end(), [](const Candidate& candidateA, const Candidate& candidateB) {
+		if (candidateA.score != candidateB.score)
+			return candidateA.score > candidateB.score;
+		if (candidateA.from != candidateB.from)
+			return candidateA.from < candidateB.from;
+		return candidateA.to < candidateB.to;
+	});
+}
+
+/* -------------------------------------------------------------------------- */
+
+Game::Path Game::path() const
+{
+	Path path;
+	path.reserve(m_states.size());
+
+	for (const State *state : m_states)
+		path.push_back({ state->from(), state->to(), state->promotion() ? state->promotion() : state->glyph() });
+
+	return path;
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::unique_lock<std::mutex> Game::lock()
+{
+	/* -- Workers share the master's solutions and callbacks -- */
+
+	if (m_master != this)
+		return std::unique_lock<std::mutex>(m_master->m_mutex);
+
+	return std::unique_lock<std::mutex>();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Game::report(EUCLIDE_Thinking *thinking)
+{
+	/* -- Add positions examined by worker to master's count, lock must be held -- */
+
+	if (m_master != this)
+	{
+		m_master->m_positions += m_positions - m_reported;
+		m_reported = m_positions;
+
+		m_master->m_count = saturated(m_master->m_count, m_count - m_reportedCount);
+		m_reportedCount = m_count;
+
+		m_master->m_statistics += m_statistics;
+		m_statistics = HashTable::Statistics();
+	}
+
+	/* -- Fill thinking counters -- */
+
+	if (thinking)
+	{
+		thinking->positions = m_master->m_positions;
+		thinking->solutions = m_master->m_count;
+
+		thinking->hashHits = m_master->m_statistics.hits;
+		thinking->hashMisses = m_master->m_statistics.misses;
+		thinking->hashEvictions = m_master->m_statistics.evictions;
+		thinking->hashProbes = m_master->m_statistics.probes;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Game::task(Path *path)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	/* -- Wait for a task, search is over when all workers are idle -- */
+
+	if ((m_idle += 1) == m_threads)
+		m_condition.notify_all();
+
+	m_condition.wait(lock, [&]() { return !m_tasks.empty() || m_aborted || (m_idle == m_threads); });
+
+	if (m_tasks.empty() || m_aborted)
+		return false;
+
+	m_idle -= 1;
+
+	/* -- Pop task -- */
+
+	*path = std::move(m_tasks.front());
+	m_tasks.pop_front();
+
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Game::donate(const Path& path)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	/* -- Only donate tasks to workers that are waiting for one -- */
+
+	if (m_aborted || (m_tasks.size() >= size_t(m_idle)))
+		return false;
+
+	m_tasks.push_back(path);
+	m_condition.notify_one();
+
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Game::abort(Status status)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	/* -- Stop all workers, keeping first status -- */
+
+	if (!m_aborted)
+		m_status = status;
+
+	m_aborted = true;
+	m_condition.notify_all();
+}
+
 /* -------------------------------------------------------------------------- */
 /* -- State                                                                -- */
 /* -------------------------------------------------------------------------- */
@@ -694,6 +1521,7 @@ Game::State::State(const Problem& problem)
 {
 	m_castlings = problem.castlings();
 	m_enpassant = Nowhere;
+	m_expired = Nowhere;
 	m_color = problem.turn();
 	m_check = false;
 	m_valid = true;
@@ -721,6 +1549,7 @@ Game::State::State(const State& state, Square from, Square to, Glyph glyph, Glyp
 				m_castlings[!state.m_color][side] = false;
 
 	m_enpassant = enpassant;
+	m_expired = state.m_enpassant;
 	m_color = !state.m_color;
 	m_check = check;
 	m_valid = valid;
@@ -736,29 +1565,4 @@ Game::State::State(const State& state, Square from, Square to, Glyph glyph, Glyp
 
 /* -------------------------------------------------------------------------- */
 
-Game::Assignment::Assignment(int *assignedMoves, int *freeMoves, int extraMoves) noexcept
-	: m_assignedMoves(assignedMoves), m_freeMoves(freeMoves), m_extraMoves(extraMoves)
-{
-	*assignedMoves += extraMoves;
-	*freeMoves -= extraMoves;
-}
-
-/* -------------------------------------------------------------------------- */
-
-Game::Assignment::Assignment(Assignment&& assignment) noexcept
-	: m_assignedMoves(assignment.m_assignedMoves), m_freeMoves(assignment.m_freeMoves), m_extraMoves(assignment.m_extraMoves)
-{
-	assignment.m_extraMoves = 0;
-}
-
-/* -------------------------------------------------------------------------- */
-
-Game::Assignment::~Assignment() noexcept
-{
-	*m_assignedMoves -= m_extraMoves;
-	*m_freeMoves += m_extraMoves;
-}
-
-/* -------------------------------------------------------------------------- */
-
 }
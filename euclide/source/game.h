@@ -10,6 +10,8 @@ namespace Euclide
 class Problem;
 class Pieces;
 class Piece;
+class Tandems;
+class Frontier;
 
 /* -------------------------------------------------------------------------- */
 /* -- GameState                                                            -- */
@@ -18,25 +20,70 @@ class Piece;
 class Game
 {
 	public:
-		Game(const EUCLIDE_Options& options, const EUCLIDE_Callbacks& callbacks, const Problem& problem, const array<Pieces, NumColors>& pieces, const array<int, NumColors>& freeMoves);
+		Game(const EUCLIDE_Options& options, const EUCLIDE_Callbacks& callbacks, const Problem& problem, const array<Pieces, NumColors>& pieces, const Tandems& tandems, const array<int, NumColors>& freeMoves);
 		~Game();
 
 		void play();
 
 	protected:
 		class State;
+		struct Move
+		{
+			Square from;                                    /**< Departure square. */
+			Square to;                                      /**< Arrival square. */
+			Glyph glyph;                                    /**< Glyph after move, different than moving glyph if promoted. */
+
+			inline bool operator==(const Move& move) const
+				{ return (from == move.from) && (to == move.to) && (glyph == move.glyph); }
+			inline bool operator<(const Move& move) const
+				{ return (from != move.from) ? (from < move.from) : (to != move.to) ? (to < move.to) : (glyph < move.glyph); }
+		};
+
+		typedef std::vector<Move> Path;
+		typedef array<const State *, MaxMoves> States;
+		typedef array<uint64_t, MaxMoves / 64> Played;
+		struct Candidate { Square from; Square to; int score; };
+		typedef std::vector<Candidate> Candidates;
+		typedef matrix<int, NumSquares, NumSquares> History;
+
+		Game(Game& master);
+
+		void search();
+		void work();
+
 		bool play(const State& state);
 
 		State move(const State& state, Square from, Square to, Glyph glyph);
 		void undo(const State& state);
 
+		bool blocked();
+		bool tandems() const;
+		int distance(const Piece& piece, Square square, Squares obstructions);
+
+		bool playable(const State& state, const Move& move) const;
+		void rewind(States *states);
+		void restore(const States& states, const Path& path);
+		static Path group(const Path& path);
+		int64_t orders(const Path& path);
+		int64_t orders(const Path& path, Played& played, std::map<std::pair<Played, HashPosition>, int64_t>& counts);
+
 		bool checks(Glyph glyph, Square from, Square king) const;
-		bool checked(Square king, Color color) const;
-		bool checked(Square king, Square free, Color color) const;
+		bool checked(Square king, Squares squares, Color color) const;
 
 		bool solved() const;
+		void record();
+		bool stopped() const;
 		bool duplicate(const EUCLIDE_Solution& solution) const;
 		void cmoves(EUCLIDE_Move *moves, int nmoves) const;
+		Path path() const;
+		void order(Candidates *candidates, Color color) const;
+
+		std::unique_lock<std::mutex> lock();
+		void report(EUCLIDE_Thinking *thinking);
+
+		bool task(Path *path);
+		bool donate(const Path& path);
+		void abort(Status status);
 
 	protected:
 		class State
@@ -54,6 +101,10 @@ class Game
 					{ return m_enpassant == square; }
 				inline bool enpassant() const
 					{ return m_enpassant != Nowhere; }
+				inline Square crossed() const
+					{ return m_enpassant; }
+				inline Square expired() const
+					{ return m_expired; }
 				inline Color color() const
 					{ return m_color; }
 				inline bool check() const
@@ -79,6 +130,7 @@ class Game
 			private:
 				matrix<bool, NumColors, NumCastlingSides> m_castlings;    /**< Castling rights. */
 				Square m_enpassant;                                       /**< Possible en passant capture. */
+				Square m_expired;                                         /**< En passant capture that was possible before last move. */
 				Color m_color;                                            /**< Whose turn it is. */
 				bool m_check;                                             /**< Set if side to move is in check. */
 				bool m_valid;                                             /**< Set if state is valid. */
@@ -92,49 +144,109 @@ class Game
 				Square m_to;                                              /**< Last move arrival square. */
 		};
 
+	protected:
+		struct PieceState
+		{
+			Glyph glyph;                                    /**< Piece current glyph, different than initial if promoted. */
+			Square square;                                  /**< Piece current square, Nowhere if captured. */
+			int moves;                                      /**< Number of moves played. */
+
+			int assignedMoves;                              /**< Assigned number of moves. */
+		};
+
+		struct Pair
+		{
+			const Piece *pieceA;                            /**< First piece. */
+			const Piece *pieceB;                            /**< Second piece. */
+			int requiredMoves;                              /**< Total number of moves required by both pieces, because they obstruct each other. */
+		};
+
+		struct Detour
+		{
+			const Piece *piece;                             /**< Piece for which distance has been computed, if any. */
+			Square square;                                  /**< Square from which distance has been computed. */
+			Squares obstructions;                           /**< Squares that were avoided. */
+			int distance;                                   /**< Number of moves required to reach one of the final squares. */
+		};
+
+		struct Assignment
+		{
+			int *assignedMoves;                             /**< Piece assigned number of moves. */
+			int *freeMoves;                                 /**< Free moves of the piece color. */
+			int extraMoves;                                 /**< Number of moves transferred from the latter to the former. */
+		};
+
+		/* -- Each assignment uses at least one free move, and free moves only go negative on the last move, which assigns moves once per piece -- */
+
+		static const int MaxAssignments = MaxMoves + NumColors * MaxPieces;
+
+		typedef matrix<PieceState, MaxPieces, NumGlyphs> PieceStates;
+
+		inline PieceState& pieceState(const Piece& piece);
+		inline const PieceState& pieceState(const Piece& piece) const;
+
+		inline void assign(int *assignedMoves, int *freeMoves, int extraMoves);
+		inline void rollback(size_t assignments);
+
+		inline bool cachable(int moves) const;
+
 	private:
 		const EUCLIDE_Options m_options;                    /**< Euclide configuration. */
 		const EUCLIDE_Callbacks m_callbacks;                /**< Euclide callbacks. */
 
 		const Problem& m_problem;                           /**< Problem to solve. */
 		const array<Pieces, NumColors>& m_pieces;           /**< Problem pieces. */
+		std::vector<Pair> m_tandems;                        /**< Pair of pieces requiring more moves than on their own. */
 
-		array<ArrayOfSquares, NumGlyphs> m_captures;        /**< Legal captures, for checks. */
-		array<MatrixOfSquares, NumGlyphs> m_constraints;    /**< Move constraints, for checks. */
-		array<MatrixOfSquares, NumColors> m_lines;          /**< Line of sights, for checks and discovered checks. */
+		array<ArrayOfSquares, NumGlyphs> m_captures;                /**< Legal captures, for checks. */
+		array<const MatrixOfSquares *, NumGlyphs> m_constraints;    /**< Move constraints, for checks, shared with pieces. */
+		array<MatrixOfSquares, NumColors> m_lines;                  /**< Line of sights, for checks and discovered checks. */
 
 		array<const Piece *, NumSquares> m_board;           /**< Current board position. */
 		array<Squares, NumColors> m_position;               /**< Current occupied squares. */
 		array<Square, NumColors> m_kings;                   /**< Current king positions. */
 		array<int, NumColors> m_moves;                      /**< Current number of free moves available. */
+		array<PieceStates, NumColors> m_pieceStates;        /**< Current state of each piece and personality. */
+		matrix<Detour, NumColors, MaxPieces> m_detours;     /**< Last distance computed around obstructions, for each piece. */
 		HashPosition m_hash;                                /**< Position encoded for hash tables. */
 		Squares m_diagram;                                  /**< Occupied squares to reach. */
 
 		State m_state;                                      /**< Initial game state. */
-		std::vector<const State *> m_states;                /**< Game states, excluding initial state. */
+		Stack<const State *, MaxMoves> m_states;            /**< Game states, excluding initial state. */
+		Stack<Assignment, MaxAssignments> m_assignments;    /**< Extra move assignments performed while playing game. */
 
-		class Assignment {
-			public :
-				Assignment() noexcept { assert(false); }
-				Assignment(int *assignedMoves, int *freeMoves, int extraMoves) noexcept;
-				Assignment(const Assignment&) noexcept = delete;
-				Assignment(Assignment&& assignment) noexcept;
-				~Assignment() noexcept;
+		array<Candidates, MaxMoves> m_candidates;           /**< Candidate moves, for each depth. */
+		array<History, NumColors> m_history;                /**< Move ordering history, rewarding moves leading deep into the search tree. */
+		array<Move, MaxMoves> m_killers;                    /**< Last move at each depth that led to a complete game. */
+		unsigned m_reached;                                 /**< Largest number of moves played in current subtree. */
 
-			private:
-				int *m_assignedMoves;
-				int *m_freeMoves;
-				int m_extraMoves;
-		};
-		std::vector<Assignment> m_assignments;              /**< Extra move assignments performed while playing game. */
-
-		HashTable m_cache;                                  /**< Cache of already explored positions. */
+		std::shared_ptr<HashTable> m_cache;                 /**< Cache of already explored positions, shared with workers. */
+		std::shared_ptr<const Frontier> m_frontier;         /**< Positions leading to the diagram position, shared with workers. */
 		bool m_exhaustive;                                  /**< Exhaustive search. */
 
 		int64_t m_positions;                                /**< Number of positions examined. */
+		int64_t m_reported;                                 /**< Number of positions already added to master's count, for workers. */
+		HashTable::Statistics m_statistics;                 /**< Hash table statistics, not yet added to master's, for workers. */
 		int m_solutions;                                    /**< Number of solutions found. */
+		int64_t m_count;                                    /**< Number of solutions counted, when counting solutions rather than reporting them. */
+		int64_t m_reportedCount;                            /**< Number of solutions already added to master's count, for workers. */
+		int64_t m_deferred;                                 /**< Number of subtrees left to tasks or other workers, whose solutions are counted there. */
+		int64_t m_rejections;                               /**< Number of positions rejected because of dualistic move orders, in solving contest mode. */
 
 		std::vector<EUCLIDE_Solution> m_quickies;           /**< Solutions found while performing quick non exhaustive search. -- */
+		std::set<Path> m_groups;                            /**< Moves of solutions already reported, sorted for each side, when grouping solutions. */
+
+		Game *m_master;                                     /**< Game owning solutions and tasks, 'this' unless we are a worker. */
+		int m_threads;                                      /**< Number of worker threads, 0 for single threaded search. */
+		unsigned m_split;                                   /**< Depth at which the search tree is split into tasks, 0 if not splitting. */
+		Path m_path;                                        /**< Moves leading to the subtree explored by this worker. */
+
+		std::deque<Path> m_tasks;                           /**< Subtrees not yet explored by any worker. */
+		std::mutex m_mutex;                                 /**< Lock for tasks, solutions and user callbacks. */
+		std::condition_variable m_condition;                /**< Signaled when tasks are added or search ends. */
+		std::atomic<int> m_idle;                            /**< Number of workers waiting for a task. */
+		std::atomic<bool> m_aborted;                        /**< Set when workers should stop searching. */
+		Status m_status;                                    /**< Status that stopped workers, if aborted. */
 };
 
 /* -------------------------------------------------------------------------- */
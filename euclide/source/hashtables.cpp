@@ -8,85 +8,137 @@ namespace Euclide
 
 HashPosition::HashPosition(const Problem& problem)
 {
+	m_glyphs.fill(0);
+	m_key = 0;
+
 	for (Square square : AllSquares())
 		set(square, problem.initialPosition()[square]);
 
 	for (Color color : AllColors())
-		set(Castlings[color][KingSideCastling].from, problem.castlings()[color]);
+		if (problem.initialPosition()[Castlings[color][KingSideCastling].from] == ((color == White) ? WhiteKing : BlackKing))
+			set(Castlings[color][KingSideCastling].from, color, problem.castlings()[color]);
+}
+
+/* -------------------------------------------------------------------------- */
+
+HashPosition::HashPosition(const array<Glyph, NumSquares>& glyphs)
+{
+	m_glyphs.fill(0);
+	m_key = 0;
+
+	for (Square square : AllSquares())
+		set(square, glyphs[square]);
 }
 
 /* -------------------------------------------------------------------------- */
 
+HashPosition HashPosition::board() const
+{
+	HashPosition position = *this;
+
+	/* -- Remove castling rights and en passant, the only values that are not glyphs -- */
+
+	for (Square square : AllSquares())
+	{
+		if (glyph(square) < NumGlyphs)
+			continue;
+
+		if (square == Castlings[White][KingSideCastling].from)
+			position.set(square, WhiteKing);
+		else
+		if (square == Castlings[Black][KingSideCastling].from)
+			position.set(square, BlackKing);
+		else
+			position.set(square, Empty);
+	}
+
+	return position;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static const matrix<uint64_t, NumSquares, 16> ZobristKeys = []()
+{
+	matrix<uint64_t, NumSquares, 16> keys;
+
+	/* -- Fixed pseudo random sequence (splitmix64), empty squares have a null key -- */
+
+	uint64_t seed = 0;
+	for (Square square : AllSquares())
+	{
+		for (int value = 0; value < 16; value++)
+		{
+			uint64_t key = (seed += UINT64_C(0x9E3779B97F4A7C15));
+			key = (key ^ (key >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+			key = (key ^ (key >> 27)) * UINT64_C(0x94D049BB133111EB);
+			keys[square][value] = value ? key ^ (key >> 31) : 0;
+		}
+	}
+
+	return keys;
+}();
+
+/* -------------------------------------------------------------------------- */
+
 void HashPosition::set(Square square, Glyph glyph)
 {
 	static_assert(NumGlyphs <= 16);
 	assert(glyph <= 15);
 
-	if (square & 1)
-		m_glyphs[square >> 1] = (glyph << 4) | (m_glyphs[square >> 1] & 0x0F);
-	else
-		m_glyphs[square >> 1] = (glyph << 0) | (m_glyphs[square >> 1] & 0xF0);
+	const int shift = (square & 1) ? 4 : 0;
+	const int previous = (m_glyphs[square >> 1] >> shift) & 0x0F;
+
+	m_glyphs[square >> 1] = (glyph << shift) | (m_glyphs[square >> 1] & (0xF0 >> shift));
+	m_key ^= ZobristKeys[square][previous] ^ ZobristKeys[square][glyph];
 }
 
 /* -------------------------------------------------------------------------- */
 
-void HashPosition::set(Square square, const array<bool, NumCastlingSides>& castlings)
+void HashPosition::set(Square square, Color color, const array<bool, NumCastlingSides>& castlings)
 {
 	static_assert(NumGlyphs <= 13);
 	static_assert(NumCastlingSides == 2);
 
+	const Glyph king = (color == White) ? WhiteKing : BlackKing;
 	const int value = (castlings[KingSideCastling] ? -1 : 0) + (castlings[QueenSideCastling] ? -2 : 0);
 
-	if (square == Castlings[White][KingSideCastling].from)
-		set(square, value ? Glyph(value & 0x0F) : WhiteKing);
-	else
-	if (square == Castlings[Black][KingSideCastling].from)
-		set(square, value ? Glyph(value & 0x0F) : BlackKing);
+	/* -- Castling rights are only held by a king on its own initial square, any other king shows its plain glyph -- */
+
+	if (square == Castlings[color][KingSideCastling].from)
+		set(square, value ? Glyph(value & 0x0F) : king);
 	else
-		assert(xstd::all(castlings, false));
+		set(square, king);
+
+	assert((square == Castlings[color][KingSideCastling].from) || xstd::all(castlings, false));
 }
 
 /* -------------------------------------------------------------------------- */
 
-uint32_t HashPosition::hash() const
+void HashPosition::set(Square square, bool enpassant)
 {
-	static const bool wide = (sizeof(void *) >= sizeof(uint64_t));
-
-	if (wide)
-	{
-		uint64_t hash = UINT64_C(0xCBF29CE484222325);
-		for (unsigned k = 0; k < sizeof(m_glyphs) / sizeof(uint64_t); k++)
-		{
-			hash ^= reinterpret_cast<const uint64_t *>(m_glyphs.data())[k];
-			hash *= UINT64_C(0x00000100000001B3);
-		}
+	static_assert(NumGlyphs <= 15);
 
-		return (hash >> 32) & hash & UINT32_MAX;
-	}
-	else
-	{
-		uint32_t hash = UINT32_C(0x811C9DC5);
-		for (unsigned k = 0; k < sizeof(m_glyphs) / sizeof(uint32_t); k++)
-		{
-			hash ^= reinterpret_cast<const uint32_t *>(m_glyphs.data())[k];
-			hash *= UINT32_C(0x01000193);
-		}
+	/* -- The square crossed by a pawn is empty, and never a king square, so no glyph nor castling right is there -- */
 
-		return hash;
-	}
+	set(square, enpassant ? Glyph(0x0F) : Empty);
 }
 
 /* -------------------------------------------------------------------------- */
 
-HashTable::HashTable(int capacity)
+HashTable::HashTable(size_t memory)
 {
-	assert(intel::popcnt(uint32_t(capacity)) == 1);
-	m_size = std::min(1024, m_capacity = capacity);
+	m_chaining = 16;
 
+	/* -- Largest power of two capacity fitting in given memory -- */
+
+	m_capacity = 1024;
+	while ((m_capacity < (1 << 30)) && ((2 * size_t(m_capacity) + m_chaining) * sizeof(HashEntry) <= memory))
+		m_capacity *= 2;
+
+	m_size = std::min(1024, m_capacity);
 	m_mask = m_size - 1;
-	m_chaining = 16;
 
-	m_grow = 0;
+	m_growing = false;
 
 	/* -- Create empty hash table -- */
 
@@ -98,57 +150,220 @@ HashTable::HashTable(int capacity)
 
 void HashTable::reset()
 {
+	/* -- Not thread safe, should only be called while no one is searching -- */
+
 	for (int k = 0; k < m_size + m_chaining; k++)
-		m_entries[k].hash = std::numeric_limits<uint32_t>::max();
+	{
+		m_entries[k].sequence.store(0, std::memory_order_relaxed);
+		m_entries[k].hash.store(std::numeric_limits<uint32_t>::max(), std::memory_order_relaxed);
+	}
 }
 
 /* -------------------------------------------------------------------------- */
 
-void HashTable::insert(const HashPosition& position, int moves)
+void HashTable::insert(const HashPosition& position, int moves, const Outcome& outcome, Statistics *statistics)
 {
-	uint32_t hash = position.hash() ^ moves;
-	uint32_t index = hash & m_mask;
+	const uint64_t key = position.hash() ^ moves;
+	const HashData data = { uint32_t(key >> 32), moves, outcome, words(position) };
+	uint32_t index = uint32_t(key) & m_mask.load(std::memory_order_acquire);
 
-	for (int k = 0; k < m_chaining; k++, index++)
-		if (m_entries[index].hash == std::numeric_limits<uint32_t>::max())
+	/* -- Use first empty entry, otherwise replace the one with the least remaining moves, preferably one only valid in solving contest mode -- */
+
+	HashEntry *victim = nullptr;
+	for (int k = 0; k <= m_chaining; k++, index++)
+	{
+		HashEntry& entry = m_entries[index];
+		const uint32_t entryHash = entry.hash.load(std::memory_order_relaxed);
+		if (entryHash == std::numeric_limits<uint32_t>::max())
+		{
+			victim = &entry;
 			break;
+		}
+
+		/* -- Position may already be there, for example when it was found by a lookup -- */
+
+		HashData entryData;
+		if ((entryHash == data.hash) && read(entry, &entryData))
+		{
+			if ((entryData.hash == data.hash) && (entryData.moves == data.moves) && (entryData.glyphs == data.glyphs))
+			{
+				/* -- Entries only valid in solving contest mode tell less than the others -- */
+
+				if (entryData.outcome.contest && !data.outcome.contest)
+					write(entry, data);
 
-	m_entries[index] = { position, moves, hash };
+				return;
+			}
+		}
+
+		const bool stale = !data.outcome.contest && entry.contest.load(std::memory_order_relaxed);
+		const bool staleVictim = victim && !data.outcome.contest && victim->contest.load(std::memory_order_relaxed);
+
+		if (!victim || (stale && !staleVictim) || ((stale == staleVictim) && (entry.moves.load(std::memory_order_relaxed) >= victim->moves.load(std::memory_order_relaxed))))
+			victim = &entry;
+	}
 
-	/* -- Grow hash table if it seems pertinent -- */
+	const bool eviction = (victim->hash.load(std::memory_order_relaxed) != std::numeric_limits<uint32_t>::max());
+	if (eviction)
+		statistics->evictions += 1;
+
+	write(*victim, data);
+
+	/* -- Grow hash table when chains are full, one thread at a time -- */
+
+	const int size = m_size.load(std::memory_order_acquire);
+	if (eviction && (size < m_capacity))
+	{
+		if (!m_growing.exchange(true, std::memory_order_acquire))
+		{
+			if (m_size.load(std::memory_order_relaxed) == size)
+				grow(size);
 
-	if (m_size < m_capacity)
-		if (++m_grow >= m_size)
-			grow();
+			m_growing.store(false, std::memory_order_release);
+		}
+	}
 }
 
 /* -------------------------------------------------------------------------- */
 
-bool HashTable::contains(const HashPosition& position, int moves)
+bool HashTable::contains(const HashPosition& position, int moves, bool contest, Outcome *outcome, Statistics *statistics)
 {
-	uint32_t hash = position.hash() ^ moves;
-	uint32_t index = hash & m_mask;
+	const uint64_t key = position.hash() ^ moves;
+	const uint32_t hash = uint32_t(key >> 32);
+	uint32_t index = uint32_t(key) & m_mask.load(std::memory_order_acquire);
+	const Words glyphs = words(position);
+
+	/* -- Entries are never removed, so the chain ends at the first empty entry -- */
 
 	for (int k = 0; k <= m_chaining; k++, index++)
-		if (m_entries[index].hash == hash)
-			if (m_entries[index].moves == moves)
-				if (m_entries[index].position == position)
-					return true;
+	{
+		const uint32_t entryHash = m_entries[index].hash.load(std::memory_order_relaxed);
+		statistics->probes += 1;
+
+		if (entryHash == std::numeric_limits<uint32_t>::max())
+			break;
+
+		if (entryHash != hash)
+			continue;
 
+		/* -- Position leads nowhere, or to as many solutions, if it already did with the same number of moves -- */
+
+		HashData entryData;
+		if (read(m_entries[index], &entryData))
+		{
+			if ((entryData.hash == hash) && (entryData.moves == moves) && (entryData.glyphs == glyphs))
+			{
+				/* -- Positions that only lead nowhere when rejecting dualistic move orders are ignored in exhaustive search -- */
+
+				if (entryData.outcome.contest && !contest)
+					continue;
+
+				*outcome = entryData.outcome;
+				statistics->hits += 1;
+				return true;
+			}
+		}
+	}
+
+	statistics->misses += 1;
 	return false;
 }
 
 /* -------------------------------------------------------------------------- */
 
-void HashTable::grow()
+void HashTable::grow(int size)
+{
+	assert(size < m_capacity);
+
+	/* -- Duplicate entries in new upper half, not yet reachable by other threads -- */
+
+	for (int k = size + m_chaining; k < 2 * size + m_chaining; k++)
+	{
+		m_entries[k].sequence.store(0, std::memory_order_relaxed);
+		m_entries[k].hash.store(std::numeric_limits<uint32_t>::max(), std::memory_order_relaxed);
+	}
+
+	for (int k = 0; k < size; k++)
+	{
+		HashData data;
+		if (read(m_entries[k], &data))
+			write(m_entries[k + size], data);
+	}
+
+	/* -- Publish new size -- */
+
+	m_mask.store(2 * size - 1, std::memory_order_release);
+	m_size.store(2 * size, std::memory_order_release);
+}
+
+/* -------------------------------------------------------------------------- */
+
+HashTable::Statistics& HashTable::Statistics::operator+=(const Statistics& statistics)
+{
+	hits += statistics.hits;
+	misses += statistics.misses;
+	evictions += statistics.evictions;
+	probes += statistics.probes;
+
+	return *this;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool HashTable::read(const HashEntry& entry, HashData *data)
 {
-	assert(m_size < m_capacity);
+	/* -- Fail if entry is being written, or has been written while reading it -- */
 
-	std::copy_n(m_entries.get(), m_size, m_entries.get() + m_size);
-	m_mask = (m_size *= 2) - 1;
+	const uint32_t sequence = entry.sequence.load(std::memory_order_acquire);
+	if (sequence & 1)
+		return false;
+
+	for (size_t k = 0; k < data->glyphs.size(); k++)
+		data->glyphs[k] = entry.glyphs[k].load(std::memory_order_relaxed);
+
+	data->hash = entry.hash.load(std::memory_order_relaxed);
+	data->moves = entry.moves.load(std::memory_order_relaxed);
+	data->outcome.solutions = entry.solutions.load(std::memory_order_relaxed);
+	data->outcome.contest = entry.contest.load(std::memory_order_relaxed);
+
+	std::atomic_thread_fence(std::memory_order_acquire);
+	return entry.sequence.load(std::memory_order_relaxed) == sequence;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void HashTable::write(HashEntry& entry, const HashData& data)
+{
+	/* -- Give up if another thread is writing the same entry -- */
+
+	uint32_t sequence = entry.sequence.load(std::memory_order_relaxed);
+	if ((sequence & 1) || !entry.sequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_relaxed))
+		return;
+
+	std::atomic_thread_fence(std::memory_order_release);
+
+	/* -- Write entry -- */
+
+	for (size_t k = 0; k < data.glyphs.size(); k++)
+		entry.glyphs[k].store(data.glyphs[k], std::memory_order_relaxed);
+
+	entry.solutions.store(data.outcome.solutions, std::memory_order_relaxed);
+	entry.contest.store(data.outcome.contest, std::memory_order_relaxed);
+	entry.moves.store(int16_t(data.moves), std::memory_order_relaxed);
+	entry.hash.store(data.hash, std::memory_order_relaxed);
+
+	entry.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+/* -------------------------------------------------------------------------- */
+
+HashTable::Words HashTable::words(const HashPosition& position)
+{
+	static_assert(sizeof(Words) == sizeof(position.m_glyphs));
 
-	for (int k = m_size; k < m_size + m_chaining; k++)
-		m_entries[k].hash = std::numeric_limits<uint32_t>::max();
+	Words words;
+	std::memcpy(words.data(), position.m_glyphs.data(), sizeof(words));
+	return words;
 }
 
 /* -------------------------------------------------------------------------- */
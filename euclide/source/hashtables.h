@@ -15,6 +15,7 @@ class HashPosition
 	public:
 		HashPosition() {}
 		HashPosition(const Problem& problem);
+		HashPosition(const array<Glyph, NumSquares>& glyphs);
 
 		class Assignment
 		{
@@ -22,8 +23,8 @@ class HashPosition
 				Assignment(HashPosition& position, Square square) : m_position(position), m_square(square) {}
 				void operator=(Glyph glyph)
 					{ m_position.set(m_square, glyph); }
-				void operator=(const array<bool, NumCastlingSides>& castlings)
-					{ m_position.set(m_square, castlings); }
+				void operator=(bool enpassant)
+					{ m_position.set(m_square, enpassant); }
 
 			private:
 				HashPosition& m_position;
@@ -33,20 +34,35 @@ class HashPosition
 		inline Assignment operator[](Square square)
 			{ return Assignment(*this, square); }
 
+		inline void castlings(Color color, Square king, const array<bool, NumCastlingSides>& castlings)
+			{ set(king, color, castlings); }
+
 	public:
 		inline bool operator==(const HashPosition& position) const
 			{ return m_glyphs == position.m_glyphs; }
 		inline bool operator!=(const HashPosition& position) const
 			{ return m_glyphs != position.m_glyphs; }
+		inline bool operator<(const HashPosition& position) const
+			{ return m_glyphs < position.m_glyphs; }
+
+		inline Glyph glyph(Square square) const
+			{ return Glyph((m_glyphs[square >> 1] >> ((square & 1) ? 4 : 0)) & 0x0F); }
+
+		HashPosition board() const;
 
-		uint32_t hash() const;
+		inline uint64_t hash() const
+			{ return m_key; }
 
 	protected:
 		void set(Square square, Glyph glyph);
-		void set(Square square, const array<bool, NumCastlingSides>& castlings);
+		void set(Square square, Color color, const array<bool, NumCastlingSides>& castlings);
+		void set(Square square, bool enpassant);
 
 	private:
-		array<uint8_t, NumSquares / 2> m_glyphs;    /**< Glyphs, four bits each. Castling rights are encoded with the kings. */
+		array<uint8_t, NumSquares / 2> m_glyphs;    /**< Glyphs, four bits each. Castling rights are encoded with the kings, en passant on the square crossed. */
+		uint64_t m_key;                             /**< Zobrist key, updated incrementally. */
+
+		friend class HashTable;
 };
 
 /* -------------------------------------------------------------------------- */
@@ -54,24 +70,73 @@ class HashPosition
 class HashTable
 {
 	public:
-		HashTable(int capacity);
+		struct Statistics
+		{
+			Statistics() : hits(0), misses(0), evictions(0), probes(0) {}
+			Statistics& operator+=(const Statistics& statistics);
+
+			int64_t hits;         /**< Number of lookups that found the position. */
+			int64_t misses;       /**< Number of lookups that did not find the position. */
+			int64_t evictions;    /**< Number of entries replaced by newer positions. */
+			int64_t probes;       /**< Number of entries examined by lookups. */
+		};
+
+		struct Outcome
+		{
+			Outcome(int64_t solutions = 0, bool contest = false) : solutions(solutions), contest(contest) {}
+
+			int64_t solutions;    /**< Number of solutions reached from position, only when counting solutions. */
+			bool contest;         /**< Set if position was only found to lead nowhere because dualistic move orders were rejected, in solving contest mode. */
+		};
+
+	public:
+		HashTable(size_t memory);
 		void reset();
 
-		void insert(const HashPosition& position, int moves);
-		bool contains(const HashPosition& position, int moves);
+		void insert(const HashPosition& position, int moves, const Outcome& outcome, Statistics *statistics);
+		bool contains(const HashPosition& position, int moves, bool contest, Outcome *outcome, Statistics *statistics);
+
+		inline int capacity() const
+			{ return m_capacity; }
+		inline size_t memory() const
+			{ return (size_t(m_capacity) + m_chaining) * sizeof(HashEntry); }
 
 	protected:
-		void grow();
+		void grow(int size);
+
+	private:
+		typedef array<uint64_t, NumSquares / 16> Words;
+
+		struct HashData
+		{
+			uint32_t hash;                                          /**< Upper half of position hash value, xored with number of moves. */
+			int32_t moves;                                          /**< Number of moves played. */
+			Outcome outcome;                                        /**< Number of solutions reached from position, and whether this only holds in solving contest mode. */
+			Words glyphs;                                           /**< Position glyphs, as 64-bit words. */
+		};
+
+		struct HashEntry
+		{
+			std::atomic<uint32_t> sequence;                         /**< Sequence number, odd while the entry is being written. */
+			std::atomic<uint32_t> hash;                             /**< Upper half of position hash value, xored with number of moves. */
+			std::atomic<int16_t> moves;                             /**< Number of moves played. */
+			std::atomic<bool> contest;                              /**< Set if entry only holds in solving contest mode. */
+			std::atomic<int64_t> solutions;                         /**< Number of solutions reached from position. */
+			array<std::atomic<uint64_t>, NumSquares / 16> glyphs;   /**< Position glyphs, as 64-bit words. */
+		};
+
+		static bool read(const HashEntry& entry, HashData *data);
+		static void write(HashEntry& entry, const HashData& data);
+		static Words words(const HashPosition& position);
 
 	private:
-		struct HashEntry { HashPosition position; int32_t moves; uint32_t hash; };
 		std::unique_ptr<HashEntry[]> m_entries;    /**< Hash table of positions and associated data. */
 
 		int m_capacity;                            /**< Maximum capacity of the hash table. */
-		int m_size;                                /**< Current size of the hash table. */
-		int m_grow;                                /**< State variable used to grow hash table. */
+		std::atomic<int> m_size;                   /**< Current size of the hash table. */
+		std::atomic<bool> m_growing;               /**< Set while a thread is growing the hash table. */
 
-		uint32_t m_mask;                           /**< Mask for hash function. */
+		std::atomic<uint32_t> m_mask;              /**< Mask for hash function. */
 		int m_chaining;                            /**< Maximum number of entries to check for a given hash index. */
 };
 
@@ -24,15 +24,23 @@
 
 #include <array>
 #include <algorithm>
+#include <atomic>
 #include <bitset>
+#include <condition_variable>
+#include <deque>
 #include <functional>
 #include <iterator>
+#include <limits>
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <new>
 #include <numeric>
 #include <queue>
+#include <set>
+#include <thread>
+#include <tuple>
 #include <vector>
 
 using std::array;
@@ -66,9 +74,11 @@ static inline bool maybe(tribool value) { return bool(value) || unknown(value);
 
 #include "utilities/algorithm.h"
 #include "utilities/bitset.h"
+#include "utilities/deque.h"
 #include "utilities/iterator.h"
 #include "utilities/matrix.h"
 #include "utilities/queue.h"
+#include "utilities/stack.h"
 
 /* -------------------------------------------------------------------------- */
 
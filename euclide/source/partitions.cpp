@@ -188,22 +188,9 @@ bool Partition::split(Pieces& pieces, int freeMoves, int freeCaptures, Targets&
 		}
 	}
 
-	/* -- Split partition, working with subsets of men if there are too many possible men --  */
+	/* -- Split partition -- */
 
-	static constexpr int MaxMen = 8;
-
-	bool updated = false;
-	if (m_men.count() > MaxMen)
-		for (Glyph glyph : ValidGlyphs(m_glyphs))
-			if (split(pieces, glyph, availableMoves, availableCaptures, targets, captures))
-				updated = true;
-
-	if (split(pieces, Empty, availableMoves, availableCaptures, targets, captures))
-		updated = true;
-
-	/* -- Done -- */
-
-	return updated;
+	return split(pieces, Empty, availableMoves, availableCaptures, targets, captures);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -239,16 +226,10 @@ bool Partition::split(Pieces& pieces, Glyph glyph, int availableMoves, int avail
 	if (m < s)
 		throw NoSolution;
 
-	/* -- Early exit if computations are too expensive -- */
-
-	static constexpr int MaxMen = 8;
-	if (m > MaxMen)
-		return false;
-
-	/* -- Prefetch required moves and captures -- */
+	/* -- Prefetch required moves and captures, men left without destination use extra destinations that cost nothing -- */
 
 	struct Cost { int moves; int captures; };
-	matrix<Cost, MaxMen, MaxMen> costs;
+	matrix<Cost, MaxPieces, MaxPieces> costs;
 
 	for (int i = 0; i < m; i++)
 	{
@@ -261,45 +242,111 @@ bool Partition::split(Pieces& pieces, Glyph glyph, int availableMoves, int avail
 			costs[i][j].moves = destination.men[man] ? std::max(destination.glyph ? pieces[man].requiredMovesTo(destination.squares, destination.glyph) : pieces[man].requiredMovesTo(destination.squares), pieces[man].requiredMoves()) : Infinity;
 			costs[i][j].captures = destination.men[man] ? std::max(destination.glyph ? pieces[man].requiredCapturesTo(destination.squares, destination.glyph) : pieces[man].requiredCapturesTo(destination.squares), pieces[man].requiredCaptures()) : Infinity;
 		}
+
+		for (int j = s; j < m; j++)
+			costs[i][j] = { 0, 0 };
 	}
 
-	/* -- Try all permutations -- */
+	/* -- Minimum number of moves required to assign a subset of men to the first (or last) destinations, for each number of captures -- */
 
-	array<Men, MaxPieces> permutations;
-	array<Squares, MaxPieces> squares;
+	const int c = std::max(availableCaptures + 1, 0);
+	const int subsets = 1 << m;
 
-	int indices[MaxMen];
-	for (int k = 0; k < m; k++)
-		indices[k] = k;
+	std::vector<int> first(size_t(subsets) * c, Infinity);
+	std::vector<int> last(size_t(subsets) * c, Infinity);
 
-	do
-	{
-		int requiredMoves = 0, requiredCaptures = 0;
+	auto assign = [&](std::vector<int>& required, bool reverse) {
+		if (c)
+			required[0] = 0;
 
-		for (int k = 0; k < s; k++)
+		for (int subset = 0; subset < subsets; subset++)
 		{
-			requiredMoves += costs[indices[k]][k].moves;
-			requiredCaptures += costs[indices[k]][k].captures;
+			const int k = intel::popcnt(uint32_t(subset));
+			if (k >= m)
+				continue;
+
+			const int j = reverse ? m - 1 - k : k;
+
+			for (int i = 0; i < m; i++)
+			{
+				if ((subset >> i) & 1)
+					continue;
+
+				const Cost& cost = costs[i][j];
+				for (int captures = 0; captures + cost.captures < c; captures++)
+				{
+					const int moves = required[size_t(subset) * c + captures] + cost.moves;
+					if (moves <= availableMoves)
+						xstd::minimize(required[size_t(subset | (1 << i)) * c + captures + cost.captures], moves);
+				}
+			}
 		}
+	};
+
+	assign(first, false);
+	assign(last, true);
+
+	/* -- Minimum number of moves required when assigning each man to each destination, for each number of captures -- */
 
-		if ((requiredMoves <= availableMoves) && (requiredCaptures <= availableCaptures))
+	std::vector<int> required(size_t(m) * s * c, Infinity);
+
+	for (int subset = 0; subset < subsets; subset++)
+	{
+		const int k = intel::popcnt(uint32_t(subset));
+		if (k >= s)
+			continue;
+
+		for (int i = 0; i < m; i++)
 		{
-			for (int k = 0; k < m; k++)
-				permutations[k].set(men[indices[k]]);
+			if ((subset >> i) & 1)
+				continue;
 
-			for (int k = 0; k < s; k++)
+			const Cost& cost = costs[i][k];
+			const int others = (subsets - 1) & ~subset & ~(1 << i);
+
+			for (int capturesA = 0; capturesA + cost.captures < c; capturesA++)
+			{
+				const int movesA = first[size_t(subset) * c + capturesA];
+				if (movesA + cost.moves > availableMoves)
+					continue;
+
+				for (int capturesB = 0; capturesA + cost.captures + capturesB < c; capturesB++)
+				{
+					const int moves = movesA + cost.moves + last[size_t(others) * c + capturesB];
+					if (moves <= availableMoves)
+						xstd::minimize(required[(size_t(i) * s + k) * c + capturesA + cost.captures + capturesB], moves);
+				}
+			}
+		}
+	}
+
+	/* -- Men that may be assigned to each destination, and squares they may reach with moves and captures left -- */
+
+	array<Men, MaxPieces> permutations;
+	array<Squares, MaxPieces> squares;
+
+	for (int i = 0; i < m; i++)
+	{
+		for (int k = 0; k < s; k++)
+		{
+			for (int requiredCaptures = 0; requiredCaptures < c; requiredCaptures++)
 			{
-				const int myAvailableMoves = costs[indices[k]][k].moves + (availableMoves - requiredMoves);
-				const int myAvailableCaptures = costs[indices[k]][k].captures + (availableCaptures - requiredCaptures);
+				const int requiredMoves = required[(size_t(i) * s + k) * c + requiredCaptures];
+				if (requiredMoves > availableMoves)
+					continue;
+
+				permutations[k].set(men[i]);
+
+				const int myAvailableMoves = costs[i][k].moves + (availableMoves - requiredMoves);
+				const int myAvailableCaptures = costs[i][k].captures + (availableCaptures - requiredCaptures);
 
 				const Destination& destination = m_destinations[destinations[k]];
-				const Squares reachableSquares = destination.glyph ? pieces[men[indices[k]]].reachableSquares(destination.squares, myAvailableMoves, myAvailableCaptures, destination.glyph) : pieces[men[indices[k]]].reachableSquares(destination.squares, myAvailableMoves, myAvailableCaptures);
+				const Squares reachableSquares = destination.glyph ? pieces[men[i]].reachableSquares(destination.squares, myAvailableMoves, myAvailableCaptures, destination.glyph) : pieces[men[i]].reachableSquares(destination.squares, myAvailableMoves, myAvailableCaptures);
 
-				squares[indices[k]] |= reachableSquares;
+				squares[i] |= reachableSquares;
 			}
 		}
-
-	} while (std::next_permutation(indices, indices + m));
+	}
 
 	/* -- Update targets and captures -- */
 
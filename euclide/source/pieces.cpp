@@ -158,6 +158,7 @@ Piece::Piece(const Problem& problem, Square square, Man man, Glyph glyph, triboo
 
 	/* -- Update possible moves -- */
 
+	m_epoch = 0;
 	m_update = true;
 	update();
 }
@@ -381,9 +382,13 @@ void Piece::bypassObstacles(const Piece& blocker)
 
 /* -------------------------------------------------------------------------- */
 
-int Piece::mutualInteractions(Piece& pieceA, Piece& pieceB, const array<int, NumColors>& freeMoves, bool fast)
+Piece::Interactions::Interactions(Piece& pieceA, Piece& pieceB, const array<int, NumColors>& freeMoves, bool fast)
 {
-	const int requiredMoves = pieceA.m_requiredMoves + pieceB.m_requiredMoves;
+	/* -- Pieces are only read here, so that interactions between several pairs of pieces can be computed concurrently -- */
+
+	m_requiredMoves = pieceA.m_requiredMoves + pieceB.m_requiredMoves;
+	m_fast = fast;
+
 	const bool enemies = pieceA.m_color != pieceB.m_color;
 
 	/* -- Don't bother if these two pieces can not interact with each other -- */
@@ -394,42 +399,54 @@ int Piece::mutualInteractions(Piece& pieceA, Piece& pieceB, const array<int, Num
 	};
 
 	if (!(routes[0] & routes[1]))
-		return requiredMoves;
+		return;
 
 	/* -- Interactions with captures are not yet implemented -- */
 
 	if (maybe(pieceA.m_captured) || maybe(pieceB.m_captured))
-		return requiredMoves;
+		return;
 
 	/* -- Interactions with promotions are not yet implemented -- */
 
 	if (maybe(pieceA.m_promoted) || maybe(pieceB.m_promoted))
-		return requiredMoves;
+		return;
 
 	/* -- Compute available moves for these two pieces -- */
 
 	const int availableMoves = std::min(
 		pieceA.m_availableMoves + pieceB.m_availableMoves - (enemies ? 0 : std::min(pieceA.m_freeMoves, pieceB.m_freeMoves)),
-		requiredMoves + freeMoves[pieceA.m_color] + (enemies ? freeMoves[pieceB.m_color] : 0)
+		m_requiredMoves + freeMoves[pieceA.m_color] + (enemies ? freeMoves[pieceB.m_color] : 0)
 	);
 
 	/* -- Use fast method if the search space is too large -- */
 
 	const int threshold = 5000;
-	if ((pieceA.nmoves() * pieceB.nmoves() > threshold) || (availableMoves - requiredMoves > 20))
-		fast = true;
+	if ((pieceA.nmoves() * pieceB.nmoves() > threshold) || (availableMoves - m_requiredMoves > 20))
+		m_fast = true;
 
 	/* -- Play all possible moves with these two pieces -- */
 
-	array<State, 2> states = {
+	m_states.reset(new array<State, 2> {{
 		State(pieceA, pieceA.m_availableMoves),
 		State(pieceB, pieceB.m_availableMoves)
-	};
+	}});
 
-	const int newRequiredMoves = fast ? fastplay(states, availableMoves) : fullplay(states, availableMoves);
+	m_requiredMoves = m_fast ? fastplay(*m_states, availableMoves) : fullplay(*m_states, availableMoves);
 
-	if (newRequiredMoves >= Infinity)
+	if (m_requiredMoves >= Infinity)
 		throw NoSolution;
+}
+
+/* -------------------------------------------------------------------------- */
+
+int Piece::Interactions::apply() const
+{
+	/* -- Nothing to do if pieces do not interact -- */
+
+	if (!m_states)
+		return m_requiredMoves;
+
+	const array<State, 2>& states = *m_states;
 
 	/* -- Store required moves for each piece, if greater than the previously computed values -- */
 
@@ -439,17 +456,18 @@ int Piece::mutualInteractions(Piece& pieceA, Piece& pieceB, const array<int, Num
 
 	/* -- Early exit if we have not performed all computations -- */
 
-	if (fast)
-		return newRequiredMoves;
+	if (m_fast)
+		return m_requiredMoves;
 
-	/* -- Remove never played moves and keep track of occupied squares -- */
+	/* -- Remove never played moves and keep track of occupied squares, pieces may have been updated by other pairs since -- */
 
 	for (const State& state : states)
 	{
 		for (Square square : AllSquares())
 		{
-			if (state.moves[square] < state.piece.m_moves[square])
-				state.piece.m_moves[square] = state.moves[square], state.piece.m_update = true;
+			const Squares moves = state.moves[square] & state.piece.m_moves[square];
+			if (moves != state.piece.m_moves[square])
+				state.piece.m_moves[square] = moves, state.piece.m_update = true;
 
 			if (state.squares[square].count() == 1)
 			{
@@ -469,12 +487,12 @@ int Piece::mutualInteractions(Piece& pieceA, Piece& pieceB, const array<int, Num
 
 	/* -- Done -- */
 
-	return newRequiredMoves;
+	return m_requiredMoves;
 }
 
 /* -------------------------------------------------------------------------- */
 
-void Piece::findConsequences(const std::array<Pieces, NumColors>& pieces)
+void Piece::findConsequences(const std::array<Pieces, NumColors>& pieces, Obstructions& obstructions)
 {
 	/* -- Early exit conditions -- */
 
@@ -520,7 +538,7 @@ void Piece::findConsequences(const std::array<Pieces, NumColors>& pieces)
 
 						/* -- Find distances assuming final square is blocked, and record any extra moves required -- */
 
-						const array<int, NumSquares> rdistances = maybe(piece.m_captured) ? piece.computeDistancesTo(piece.m_possibleSquares, false) : piece.computeDistancesTo(piece.m_possibleSquares, *this, final);
+						const array<int, NumSquares>& rdistances = obstructions.distancesTo(piece, *this, maybe(piece.m_captured) ? Nowhere : final);
 						for (Square square : ValidSquares(piece.m_stops - Squares(final)))
 						{
 							const int requiredMoves = std::min(piece.m_distances[square] + rdistances[square], Infinity);
@@ -550,6 +568,30 @@ void Piece::findConsequences(const std::array<Pieces, NumColors>& pieces)
 
 /* -------------------------------------------------------------------------- */
 
+const array<int, NumSquares>& Piece::Obstructions::distancesTo(const Piece& piece, const Piece& blocker, Square obstruction)
+{
+	/* -- Blockers only matter through their glyph, which give their color, royalty and checks -- */
+
+	const Key key(&piece, piece.m_epoch, (obstruction != Nowhere) ? blocker.m_glyph : Empty, obstruction);
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		const auto found = m_distances.find(key);
+		if (found != m_distances.end())
+			return found->second;
+	}
+
+	/* -- Compute distances outside of lock, another thread may compute the same ones concurrently -- */
+
+	const array<int, NumSquares> distances = (obstruction != Nowhere) ? piece.computeDistancesTo(piece.m_possibleSquares, blocker, obstruction) : piece.computeDistancesTo(piece.m_possibleSquares, false);
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_distances.emplace(key, distances).first->second;
+}
+
+/* -------------------------------------------------------------------------- */
+
 bool Piece::update()
 {
 	bool updated = false;
@@ -563,6 +605,7 @@ bool Piece::update()
 	m_glyph ? unfold() : summarize();
 
 	m_update = false;
+	m_epoch++;
 	return true;
 }
 
@@ -868,7 +911,12 @@ void Piece::updateDistances()
 	else
 	{
 		const bool castling = (m_castlingSquare != Nowhere) && xstd::any_of(AllCastlingSides(), [&](CastlingSide side) { return is(m_castling[side]); });
-		const auto distances = computeDistances(castling ? m_castlingSquare : m_initialSquare, castling ? Nowhere : m_castlingSquare, false);
+
+		Squares initial(castling ? m_castlingSquare : m_initialSquare);
+		if (!castling && (m_castlingSquare != Nowhere))
+			initial.set(m_castlingSquare);
+
+		const auto& distances = m_paths.update(m_moves, initial, false);
 		xstd::maximize(m_distances, distances);
 	}
 }
@@ -877,7 +925,13 @@ void Piece::updateDistances()
 
 void Piece::updateDistancesTo()
 {
-	m_rdistances = computeDistancesTo(m_possibleSquares, false);
+	/* -- Castling moves cost no move when going backwards and are not handled by kept shortest paths -- */
+
+	if (m_castlingSquare == Nowhere)
+		m_rdistances = m_rpaths.update(m_moves, m_possibleSquares, true);
+	else
+		m_rdistances = computeDistancesTo(m_possibleSquares, false);
+
 	if (is(m_promoted))
 		m_pawn.rdistances = computeDistancesTo(m_promotionSquares, m_rdistances);
 }
@@ -913,6 +967,160 @@ void Piece::updateCapturesTo()
 
 /* -------------------------------------------------------------------------- */
 
+const array<int, NumSquares>& Piece::Paths::update(const ArrayOfSquares& moves, Squares sources, bool reverse)
+{
+	/* -- Distances can only be updated if sources and moves have been removed, and nothing added -- */
+
+	bool removed = !m_valid || !(sources <= m_sources);
+	for (Square from : AllSquares())
+		if (!(moves[from] <= m_moves[from]))
+			removed = true;
+
+	if (removed)
+	{
+		m_moves = moves;
+		m_sources = sources;
+		compute(reverse);
+		return m_distances;
+	}
+
+	/* -- Squares whose shortest paths may have been lost are removed sources and ends of removed shortest path moves -- */
+
+	Squares suspects = m_sources - sources;
+
+	for (Square from : AllSquares())
+	{
+		for (Square to : ValidSquares(m_moves[from] - moves[from]))
+		{
+			if (!reverse && (m_distances[from] < Infinity) && (m_distances[from] + 1 == m_distances[to]))
+				suspects.set(to);
+			if (reverse && (m_distances[to] < Infinity) && (m_distances[to] + 1 == m_distances[from]))
+				suspects.set(from);
+		}
+	}
+
+	m_moves = moves;
+	m_sources = sources;
+
+	if (suspects)
+		repair(suspects, reverse);
+
+	return m_distances;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Piece::Paths::compute(bool reverse)
+{
+	m_distances.fill(Infinity);
+
+	Squares frontier = m_sources;
+	Squares reached = frontier;
+
+	/* -- Breadth first search, one frontier at a time -- */
+
+	for (int distance = 0; frontier; distance++)
+	{
+		Squares next;
+		for (Square square : ValidSquares(frontier))
+		{
+			m_distances[square] = distance;
+			if (!reverse)
+				next |= m_moves[square];
+		}
+
+		if (reverse)
+			next = Squares([&](Square from) { return !reached[from] && (m_moves[from] & frontier); });
+
+		frontier = next - reached;
+		reached |= frontier;
+	}
+
+	m_valid = true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Piece::Paths::repair(Squares suspects, bool reverse)
+{
+	/* -- Squares sorted by distance -- */
+
+	array<Squares, NumSquares> layers;
+	for (Square square : AllSquares())
+		if (m_distances[square] < NumSquares)
+			layers[m_distances[square]].set(square);
+
+	/* -- Find squares that lost all their shortest paths, by order of distance -- */
+
+	Squares lost;
+
+	for (int distance = 0; distance < NumSquares; distance++)
+	{
+		const Squares candidates = suspects & layers[distance];
+		if (!candidates)
+			continue;
+
+		const Squares supports = (distance > 0) ? layers[distance - 1] - lost : Squares();
+		const Squares successors = (distance + 1 < NumSquares) ? layers[distance + 1] : Squares();
+
+		for (Square square : ValidSquares(candidates))
+		{
+			/* -- Square keeps its distance if it is still a source, or can still be reached from a square one move closer -- */
+
+			bool supported = (distance == 0) && m_sources[square];
+			if (!supported && (distance > 0))
+				supported = reverse ? bool(m_moves[square] & supports) : xstd::any_of(ValidSquares(supports), [&](Square from) { return m_moves[from][square]; });
+
+			if (supported)
+				continue;
+
+			/* -- Otherwise squares one move further may have lost their shortest paths too -- */
+
+			lost.set(square);
+			suspects |= reverse ? Squares([&](Square from) { return m_moves[from][square]; }, ValidSquares(successors)) : m_moves[square] & successors;
+		}
+	}
+
+	/* -- Compute new distances of these squares from the other squares, nearest squares first -- */
+
+	for (Square square : ValidSquares(lost))
+		m_distances[square] = Infinity;
+
+	for (Square square : ValidSquares(lost))
+	{
+		if (reverse)
+		{
+			for (Square to : ValidSquares(m_moves[square] - lost))
+				if (m_distances[to] < Infinity)
+					xstd::minimize(m_distances[square], m_distances[to] + 1);
+		}
+		else
+		{
+			for (Square from : AllSquares())
+				if (m_moves[from][square] && !lost[from] && (m_distances[from] < Infinity))
+					xstd::minimize(m_distances[square], m_distances[from] + 1);
+		}
+	}
+
+	while (lost)
+	{
+		Square nearest = lost.first();
+		for (Square square : ValidSquares(lost))
+			if (m_distances[square] < m_distances[nearest])
+				nearest = square;
+
+		lost.reset(nearest);
+		if (m_distances[nearest] >= Infinity)
+			break;
+
+		const Squares squares = reverse ? Squares([&](Square from) { return m_moves[from][nearest]; }, ValidSquares(lost)) : m_moves[nearest] & lost;
+		for (Square square : ValidSquares(squares))
+			xstd::minimize(m_distances[square], m_distances[nearest] + 1);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
 void Piece::updateConsequences()
 {
 	m_actions->clean();
@@ -961,42 +1169,34 @@ array<int, NumSquares> Piece::computeDistances(Square initial, Square castling,
 
 	array<int, NumSquares> distances;
 	distances.fill(Infinity);
-	distances[initial] = 0;
-	if (castling != Nowhere)
-		distances[castling] = 0;
 
-	/* -- Initialized square queue -- */
+	/* -- Initialize first frontier -- */
 
-	Queue<Square, NumSquares> queue;
-	queue.push(initial);
+	Squares frontier(initial);
 	if (castling != Nowhere)
-		queue.push(castling);
+		frontier.set(castling);
+
+	Squares reached = frontier;
 
-	/* -- Loop until every reachable square has been handled -- */
+	/* -- Loop until every reachable square has been handled, one frontier at a time -- */
 
 	const ArrayOfSquares& moves = pawn ? m_pawn.moves : m_moves;
 
-	while (!queue.empty())
+	for (int distance = 0; frontier; distance++)
 	{
-		const Square from = queue.front(); queue.pop();
-
-		/* -- Handle every possible immediate destination -- */
+		/* -- Set frontier distances and merge immediate destinations -- */
 
-		for (Square to : ValidSquares(moves[from]))
+		Squares destinations;
+		for (Square from : ValidSquares(frontier))
 		{
-			/* -- This square may have been attained by a quicker path -- */
-
-			if (distances[to] < Infinity)
-				continue;
-
-			/* -- Set square distance -- */
-
-			distances[to] = distances[from] + 1;
+			distances[from] = distance;
+			destinations |= moves[from];
+		}
 
-			/* -- Add it to queue of reachable queue -- */
+		/* -- Squares not yet reached make the next frontier -- */
 
-			queue.push(to);
-		}
+		frontier = destinations - reached;
+		reached |= frontier;
 	}
 
 	/* -- Done -- */
@@ -1010,42 +1210,40 @@ array<int, NumSquares> Piece::computeDistances(Squares promotions, const array<i
 {
 	assert(is(m_promoted));
 
-	/* -- Initialize distances and square queue -- */
+	/* -- Initialize distances -- */
 
 	array<int, NumSquares> distances;
 	distances.fill(Infinity);
 
-	Queue<Square, NumSquares> queue;
-
-	for (Square square : ValidSquares(promotions))
-		if ((distances[square] = initial[square]) < Infinity)
-			queue.push(square);
+	Squares sources([&](Square square) { return initial[square] < Infinity; }, ValidSquares(promotions));
+	Squares frontier, reached;
 
-	queue.sort([&](Square lhs, Square rhs) { return distances[lhs] < distances[rhs]; });
+	/* -- Loop until every reachable square has been handled, one frontier at a time -- */
 
-	/* -- Loop until every reachable square has been handled -- */
+	const int first = xstd::min(ValidSquares(sources), Infinity, [&](Square square) { return initial[square]; });
 
-	while (!queue.empty())
+	for (int distance = first; frontier || sources; distance++)
 	{
-		const Square from = queue.front(); queue.pop();
+		/* -- Promotion squares join the frontier when reached at their own distance -- */
 
-		/* -- Handle every possible immediate destination -- */
+		const Squares promoted([&](Square square) { return initial[square] == distance; }, ValidSquares(sources));
+		sources -= promoted;
+		frontier |= promoted - reached;
+		reached |= frontier;
 
-		for (Square to : ValidSquares(m_moves[from]))
-		{
-			/* -- This square may have been attained by a quicker path -- */
+		/* -- Set frontier distances and merge immediate destinations -- */
 
-			if (distances[to] < Infinity)
-				continue;
-
-			/* -- Set square distance -- */
-
-			distances[to] = distances[from] + 1;
+		Squares destinations;
+		for (Square from : ValidSquares(frontier))
+		{
+			distances[from] = distance;
+			destinations |= m_moves[from];
+		}
 
-			/* -- Add it to queue of reachable queue -- */
+		/* -- Squares not yet reached make the next frontier -- */
 
-			queue.push(to);
-		}
+		frontier = destinations - reached;
+		reached |= frontier;
 	}
 
 	/* -- Done -- */
@@ -1057,62 +1255,39 @@ array<int, NumSquares> Piece::computeDistances(Squares promotions, const array<i
 
 array<int, NumSquares> Piece::computeDistancesTo(Squares destinations, bool pawn) const
 {
-	/* -- Initialize distances and square queue -- */
+	/* -- Initialize distances and first frontier -- */
 
 	array<int, NumSquares> distances;
-	Queue<Square, NumSquares> squares;
+	distances.fill(Infinity);
 
-	for (Square square : AllSquares())
-		if ((distances[square] = (destinations[square] ? 0 : Infinity)) == 0)
-			squares.push(square);
+	Squares frontier = destinations;
 
 	/* -- Handle castling -- */
 
-	if ((m_castlingSquare != Nowhere) && !distances[m_castlingSquare] && distances[m_initialSquare])
-		if ((distances[m_initialSquare] = 0) == 0)
-			squares.push(m_initialSquare);
+	if ((m_castlingSquare != Nowhere) && frontier[m_castlingSquare])
+		frontier.set(m_initialSquare);
+
+	Squares reached = frontier;
 
-	/* -- Loop until every reachable square has been handled -- */
+	/* -- Loop until every reachable square has been handled, one frontier at a time -- */
 
 	const ArrayOfSquares& moves = pawn ? m_pawn.moves : m_moves;
 
-	while (!squares.empty())
+	for (int distance = 0; frontier; distance++)
 	{
-		const Square to = squares.front(); squares.pop();
-
-		/* -- Handle every possible immediate destination -- */
-
-		for (Square from : AllSquares())
-		{
-			/* -- Skip illegal moves -- */
+		for (Square to : ValidSquares(frontier))
+			distances[to] = distance;
 
-			if (!moves[from][to])
-				continue;
+		/* -- Squares not yet reached, from which the frontier can be reached in one move, make the next frontier -- */
 
-			/* -- This square may have been attained by a quicker path -- */
-
-			if (distances[from] < Infinity)
-				continue;
+		frontier = Squares([&](Square from) { return !reached[from] && (moves[from] & frontier); });
 
-			/* -- Set square distance -- */
+		/* -- Handle castling -- */
 
-			distances[from] = distances[to] + 1;
+		if ((m_castlingSquare != Nowhere) && frontier[m_castlingSquare] && !reached[m_initialSquare])
+			frontier.set(m_initialSquare);
 
-			/* -- Add it to queue of reachable squares -- */
-
-			squares.push(from);
-
-			/* -- Handle castling -- */
-
-			if (from == m_castlingSquare)
-			{
-				if (distances[m_initialSquare] < Infinity)
-					continue;
-
-				distances[m_initialSquare] = distances[m_castlingSquare];
-				squares.push(m_initialSquare);
-			}
-		}
+		reached |= frontier;
 	}
 
 	/* -- Done -- */
@@ -1124,45 +1299,34 @@ array<int, NumSquares> Piece::computeDistancesTo(Squares destinations, bool pawn
 
 array<int, NumSquares> Piece::computeDistancesTo(Squares promotions, const array<int, NumSquares>& initial) const
 {
-	/* -- Initialize distances and square queue -- */
+	/* -- Initialize distances -- */
 
 	array<int, NumSquares> distances;
-	Queue<Square, NumSquares> squares;
+	distances.fill(Infinity);
 
-	for (Square square : AllSquares())
-		if ((distances[square] = (promotions[square] ? initial[square] : Infinity)) < Infinity)
-			squares.push(square);
+	Squares sources([&](Square square) { return initial[square] < Infinity; }, ValidSquares(promotions));
+	Squares frontier, reached;
 
-	squares.sort([&](Square lhs, Square rhs) { return distances[lhs] < distances[rhs]; });
+	/* -- Loop until every reachable square has been handled, one frontier at a time -- */
 
-	/* -- Loop until every reachable square has been handled -- */
+	const int first = xstd::min(ValidSquares(sources), Infinity, [&](Square square) { return initial[square]; });
 
-	while (!squares.empty())
+	for (int distance = first; frontier || sources; distance++)
 	{
-		const Square to = squares.front(); squares.pop();
-
-		/* -- Handle every possible immediate destination -- */
-
-		for (Square from : AllSquares())
-		{
-			/* -- Skip illegal moves -- */
+		/* -- Promotion squares join the frontier at their own distance -- */
 
-			if (!m_pawn.moves[from][to])
-				continue;
+		const Squares promoted([&](Square square) { return initial[square] == distance; }, ValidSquares(sources));
+		sources -= promoted;
+		frontier |= promoted - reached;
+		reached |= frontier;
 
-			/* -- This square may have been attained by a quicker path -- */
+		for (Square to : ValidSquares(frontier))
+			distances[to] = distance;
 
-			if (distances[from] < Infinity)
-				continue;
+		/* -- Squares not yet reached, from which the frontier can be reached in one move, make the next frontier -- */
 
-			/* -- Set square distance -- */
-
-			distances[from] = distances[to] + 1;
-
-			/* -- Add it to queue of reachable squares -- */
-
-			squares.push(from);
-		}
+		frontier = Squares([&](Square from) { return !reached[from] && (m_pawn.moves[from] & frontier); });
+		reached |= frontier;
 	}
 
 	/* -- Done -- */
@@ -1181,83 +1345,116 @@ array<int, NumSquares> Piece::computeDistancesTo(Squares destinations, const Pie
 	if (&blocker == this)
 		return computeDistancesTo(destinations, false);
 
-	/* -- Initialize distances and square queue -- */
+	/* -- Remove obstructed moves -- */
+
+	ArrayOfSquares moves;
+	for (Square from : AllSquares())
+	{
+		moves[from] = Squares([&](Square to) { return !(*m_constraints)[from][to][obstruction]; }, ValidSquares(m_moves[from]));
+
+		if (obstruction == from)
+			moves[from].reset();
+
+		if (m_royal && enemies)
+			moves[from] -= (*blocker.m_checks)[obstruction];
+
+		if (blocker.m_royal && enemies)
+			if ((*m_checks)[from][obstruction])
+				moves[from].reset();
+	}
+
+	/* -- Initialize distances and first frontier -- */
 
 	array<int, NumSquares> distances;
-	Queue<Square, NumSquares> squares;
+	distances.fill(Infinity);
 
-	for (Square square : AllSquares())
-		if ((distances[square] = (destinations[square] && (square != obstruction)) ? 0 : Infinity) == 0)
-			squares.push(square);
+	Squares frontier = destinations - obstruction;
+
+	/* -- Handle castling -- */
 
-	if ((m_castlingSquare != Nowhere) && !distances[m_castlingSquare] && distances[m_initialSquare])
-		if (!(*m_constraints)[m_initialSquare][m_castlingSquare][obstruction])
-			if ((distances[m_initialSquare] = 0) == 0)
-				squares.push(m_initialSquare);
+	const bool castling = (m_castlingSquare != Nowhere) && !(*m_constraints)[m_initialSquare][m_castlingSquare][obstruction];
 
-	/* -- Loop until every reachable square has been handled -- */
+	if (castling && frontier[m_castlingSquare])
+		frontier.set(m_initialSquare);
 
-	while (!squares.empty())
+	Squares reached = frontier;
+
+	/* -- Loop until every reachable square has been handled, one frontier at a time -- */
+
+	for (int distance = 0; frontier; distance++)
 	{
-		const Square to = squares.front(); squares.pop();
+		for (Square to : ValidSquares(frontier))
+			distances[to] = distance;
 
-		/* -- Handle every possible immediate destination -- */
+		/* -- Squares not yet reached, from which the frontier can be reached in one move, make the next frontier -- */
 
-		for (Square from : AllSquares())
-		{
-			/* -- Skip illegal moves -- */
+		frontier = Squares([&](Square from) { return !reached[from] && (moves[from] & frontier); });
 
-			if (!m_moves[from][to])
-				continue;
+		/* -- Handle castling -- */
 
-			/* -- Skip obstructed moves -- */
+		if (castling && frontier[m_castlingSquare] && !reached[m_initialSquare])
+			frontier.set(m_initialSquare);
 
-			if (obstruction == from)
-				continue;
+		reached |= frontier;
+	}
 
-			if ((*m_constraints)[from][to][obstruction])
-				continue;
+	/* -- Done -- */
 
-			if (m_royal && enemies)
-				if ((*blocker.m_checks)[obstruction][to])
-					continue;
+	return distances;
+}
 
-			if (blocker.m_royal && enemies)
-				if ((*m_checks)[from][obstruction])
-					continue;
+/* -------------------------------------------------------------------------- */
 
-			/* -- This square may have been attained by a quicker path -- */
+int Piece::requiredMovesAround(Square square, Squares obstructions) const
+{
+	/* -- Initialize distances and square queue -- */
 
-			if (distances[from] < Infinity)
-				continue;
+	array<int, NumSquares> distances;
+	Queue<Square, NumSquares> squares;
 
-			/* -- Set square distance -- */
+	distances.fill(Infinity);
+	distances[square] = 0;
+	squares.push(square);
 
-			distances[from] = distances[to] + 1;
+	/* -- Handle castling -- */
 
-			/* -- Add it to queue of reachable squares -- */
+	if ((square == m_initialSquare) && (m_castlingSquare != Nowhere) && !((*m_constraints)[m_initialSquare][m_castlingSquare] & obstructions))
+		if ((distances[m_castlingSquare] = 0) == 0)
+			squares.push(m_castlingSquare);
 
-			squares.push(from);
+	/* -- Loop until one of the final squares is reached, obstructed squares can not be crossed nor reached -- */
 
-			/* -- Handle castling -- */
+	const Squares destinations = m_possibleSquares - obstructions;
 
-			if (from == m_castlingSquare)
-			{
-				if (distances[m_initialSquare] < Infinity)
-					continue;
+	while (!squares.empty())
+	{
+		const Square from = squares.front(); squares.pop();
 
-				if ((*m_constraints)[m_initialSquare][m_castlingSquare][obstruction])
-					continue;
+		if (destinations[from])
+			return distances[from];
 
-				distances[m_initialSquare] = distances[m_castlingSquare];
-				squares.push(m_initialSquare);
-			}
+		for (Square to : ValidSquares(m_moves[from] - obstructions))
+		{
+			/* -- Skip obstructed moves -- */
+
+			if ((*m_constraints)[from][to] & obstructions)
+				continue;
+
+			/* -- This square may have been attained by a quicker path -- */
+
+			if (distances[to] < Infinity)
+				continue;
+
+			/* -- Set square distance and add it to queue of reachable squares -- */
+
+			distances[to] = distances[from] + 1;
+			squares.push(to);
 		}
 	}
 
-	/* -- Done -- */
+	/* -- Final squares can not be reached -- */
 
-	return distances;
+	return Infinity;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -1268,52 +1465,48 @@ array<int, NumSquares> Piece::computeCaptures(Square initial, Square castling, b
 
 	array<int, NumSquares> captures;
 	captures.fill(Infinity);
-	captures[initial] = 0;
-	if (castling != Nowhere)
-		captures[castling] = 0;
 
-	/* -- Initialize squares to process -- */
+	/* -- Initialize first frontier -- */
 
-	Squares candidates(initial);
+	Squares frontier(initial);
 	if (castling != Nowhere)
-		candidates.set(castling);
+		frontier.set(castling);
+
+	Squares reached = frontier;
 
 	/* -- Loop until every reachable square has been handled, by order of number of captures -- */
 
 	const ArrayOfSquares& moves = pawn ? m_pawn.moves : m_moves;
 	const ArrayOfSquares *xmoves = pawn ? m_pawn.xmoves : m_xmoves;
 
-	while (candidates)
+	for (int required = 0; frontier; required++)
 	{
-		Squares squares = candidates;
-		candidates.reset();
+		/* -- Extend frontier with squares reached without capturing -- */
 
-		while (squares)
+		for (Squares squares = frontier; squares; )
 		{
 			const Square from = squares.pop();
+			const Squares destinations = (xmoves ? moves[from] - (*xmoves)[from] : moves[from]) - reached;
 
-			/* -- Handle every possible immediate destination -- */
-
-			for (Square to : ValidSquares(moves[from]))
-			{
-				/* -- This square may have been attained using less captures -- */
-
-				const int required = captures[from] + (xmoves && (*xmoves)[from][to]);
-				if (required >= captures[to])
-					continue;
+			frontier |= destinations;
+			squares |= destinations;
+			reached |= destinations;
+		}
 
-				/* -- Set required captures -- */
+		/* -- Set required captures and merge destinations reached by capturing -- */
 
-				captures[to] = required;
+		Squares destinations;
+		for (Square from : ValidSquares(frontier))
+		{
+			captures[from] = required;
+			if (xmoves)
+				destinations |= moves[from] & (*xmoves)[from];
+		}
 
-				/* -- Add it to queue of squares -- */
+		/* -- Squares not yet reached make the next frontier -- */
 
-				if (captures[to] > captures[from])
-					candidates.set(to);
-				else
-					squares.set(to);
-			}
-		}
+		frontier = destinations - reached;
+		reached |= frontier;
 	}
 
 	/* -- Done -- */
@@ -1372,49 +1565,38 @@ array<int, NumSquares> Piece::computeCapturesTo(Squares destinations, bool pawn)
 {
 	assert(pawn ? m_pawn.xmoves : m_xmoves);
 
-	/* -- Initialize captures and square queue -- */
+	/* -- Initialize captures and first frontier -- */
 
 	array<int, NumSquares> captures;
-	Queue<Square, 8 * NumSquares> squares;
-
 	captures.fill(Infinity);
 
-	for (Square square : AllSquares())
-		if ((captures[square] = destinations[square] ? 0 : Infinity) < Infinity)
-			squares.push(square);
+	Squares frontier = destinations;
+	Squares reached = frontier;
 
-	/* -- Loop until every reachable square has been handled -- */
+	/* -- Loop until every reachable square has been handled, by order of number of captures -- */
 
 	const ArrayOfSquares& moves = pawn ? m_pawn.moves : m_moves;
-	const ArrayOfSquares *xmoves = pawn ? m_pawn.xmoves : m_xmoves;
+	const ArrayOfSquares& xmoves = pawn ? *m_pawn.xmoves : *m_xmoves;
 
-	while (!squares.empty())
+	for (int required = 0; frontier; required++)
 	{
-		const Square to = squares.front(); squares.pop();
+		/* -- Extend frontier with squares from which it can be reached without capturing -- */
 
-		/* -- Handle every possible immediate destination -- */
-
-		for (Square from : AllSquares())
+		for (Squares squares = frontier; squares; )
 		{
-			/* -- Skip illegal moves -- */
-
-			if (!moves[from][to])
-				continue;
+			squares = Squares([&](Square from) { return !reached[from] && ((moves[from] - xmoves[from]) & squares); });
 
-			/* -- This square may have been attained using less captures -- */
-
-			const int required = captures[to] + (*xmoves)[from][to];
-			if (required >= captures[from])
-				continue;
-
-			/* -- Set square required number of captures -- */
+			frontier |= squares;
+			reached |= squares;
+		}
 
-			captures[from] = required;
+		for (Square to : ValidSquares(frontier))
+			captures[to] = required;
 
-			/* -- Add it to queue of reachable squares -- */
+		/* -- Squares from which the frontier can be reached by capturing make the next frontier -- */
 
-			squares.push(from);
-		}
+		frontier = Squares([&](Square from) { return !reached[from] && (moves[from] & xmoves[from] & frontier); });
+		reached |= frontier;
 	}
 
 	/* -- Done -- */
@@ -1426,16 +1608,24 @@ array<int, NumSquares> Piece::computeCapturesTo(Squares destinations, bool pawn)
 
 int Piece::fastplay(array<State, 2>& states, int availableMoves)
 {
-	TwoPieceFastCache cache;
-	return fastplay(states, availableMoves, cache);
+	/* -- Cache is too large to be built for each pair of pieces, keep one for each thread, as analysis threads are kept for the whole solving -- */
+
+	static thread_local std::unique_ptr<TwoPieceFastCache> cache(new TwoPieceFastCache());
+	cache->reset();
+
+	return fastplay(states, availableMoves, *cache);
 }
 
 /* -------------------------------------------------------------------------- */
 
 int Piece::fullplay(array<State, 2>& states, int availableMoves)
 {
-	TwoPieceCache cache;
-	return fullplay(states, availableMoves, availableMoves, cache);
+	/* -- Cache is too large to be built for each pair of pieces, keep one for each thread, as analysis threads are kept for the whole solving -- */
+
+	static thread_local std::unique_ptr<TwoPieceCache> cache(new TwoPieceCache());
+	cache->reset();
+
+	return fullplay(states, availableMoves, availableMoves, *cache);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -1443,7 +1633,12 @@ int Piece::fullplay(array<State, 2>& states, int availableMoves)
 int Piece::fastplay(array<State, 2>& states, int availableMoves, TwoPieceFastCache& cache)
 {
 	typedef TwoPieceFastCache::Position Position;
-	Queue<Position, 8 * NumSquares * NumSquares> queue;
+
+	/* -- Queue grows to the size of largest searches, keep one for each thread -- */
+
+	static thread_local Deque<Position> positions;
+	Deque<Position>& queue = positions;
+	queue.clear();
 
 	int requiredMoves = Infinity;
 
@@ -1453,14 +1648,15 @@ int Piece::fastplay(array<State, 2>& states, int availableMoves, TwoPieceFastCac
 	/* -- Initial position -- */
 
 	Position initial(states[0].piece.m_initialSquare, 0, states[1].piece.m_initialSquare, 0);
-	queue.push(initial);
+	queue.push_back(initial);
 	cache.add(initial);
 
-	/* -- Loop -- */
+	/* -- Loop, positions reached without playing a move are explored first -- */
 
-	for ( ; !queue.empty(); queue.pop())
+	while (!queue.empty())
 	{
-		const Position& position = queue.front();
+		const Position position = queue.front();
+		queue.pop_front();
 
 		/* -- Check if we have reached our goal -- */
 
@@ -1502,7 +1698,7 @@ int Piece::fastplay(array<State, 2>& states, int availableMoves, TwoPieceFastCac
 					{
 						/* -- Insert resulting position in front of queue -- */
 
-						queue.pass(next, 1);
+						queue.push_front(next);
 						cache.add(next);
 					}
 				}
@@ -1567,19 +1763,9 @@ int Piece::fastplay(array<State, 2>& states, int availableMoves, TwoPieceFastCac
 							if (position.moves[k] || (*xpiece.m_checks)[other][from] || (*xpiece.m_checks)[other][Castlings[piece.m_color][side].free])
 								continue;
 
-				/* -- Safeguard if maximum queue size is insufficient -- */
-
-				assert(!queue.full());
-				if (queue.full())
-				{
-					states[0].requiredMoves = states[0].piece.m_requiredMoves;
-					states[1].requiredMoves = states[1].piece.m_requiredMoves;
-					return states[0].requiredMoves + states[1].requiredMoves;
-				}
-
 				/* -- Play move and add it to cache -- */
 
-				queue.push(next);
+				queue.push_back(next);
 				cache.add(next);
 			}
 		}
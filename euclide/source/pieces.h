@@ -43,9 +43,10 @@ class Piece
 		void setVisitedSquares(Squares visits);
 
 		void bypassObstacles(const Piece& blocker);
-		static int mutualInteractions(Piece& pieceA, Piece& pieceB, const array<int, NumColors>& freeMoves, bool fast);
+		class Interactions;
 
-		void findConsequences(const std::array<Pieces, NumColors>& pieces);
+		class Obstructions;
+		void findConsequences(const std::array<Pieces, NumColors>& pieces, Obstructions& obstructions);
 
 		bool update();
 
@@ -62,6 +63,11 @@ class Piece
 		inline bool royal() const
 			{ return m_royal; }
 
+		inline int epoch() const
+			{ return m_epoch; }
+		inline bool updated() const
+			{ return m_update; }
+
 		inline tribool castling(CastlingSide side) const
 			{ return m_castling[side]; }
 		inline tribool captured() const
@@ -165,6 +171,8 @@ class Piece
 		const Action& action(Square from, Square to) const;
 		const Consequences& consequences(Square from, Square to) const;
 
+		int requiredMovesAround(Square square, Squares obstructions) const;
+
 	public:
 		inline bool operator==(const Piece& piece) const
 			{ return this == &piece; }
@@ -190,6 +198,27 @@ class Piece
 		array<int, NumSquares> computeCaptures(Squares promotions, const array<int, NumSquares>& initial) const;
 		array<int, NumSquares> computeCapturesTo(Squares destinations, bool pawn) const;
 
+	protected:
+		class Paths
+		{
+			public:
+				Paths() : m_valid(false) {}
+
+				const array<int, NumSquares>& update(const ArrayOfSquares& moves, Squares sources, bool reverse);
+				inline void reset()
+					{ m_valid = false; }
+
+			protected:
+				void compute(bool reverse);
+				void repair(Squares suspects, bool reverse);
+
+			private:
+				ArrayOfSquares m_moves;                 /**< Moves for which distances were computed. */
+				Squares m_sources;                      /**< Squares at distance zero. */
+				array<int, NumSquares> m_distances;     /**< Distances from sources, or to sources in reverse mode. */
+				bool m_valid;                           /**< Set if above distances were computed. */
+		};
+
 	protected:
 		struct State
 		{
@@ -219,6 +248,31 @@ class Piece
 		static int fastplay(array<State, 2>& states, int availableMoves, TwoPieceFastCache& cache);
 		static int fullplay(array<State, 2>& states, int availableMoves, int maximumMoves, TwoPieceCache& cache);
 
+	public:
+		class Interactions
+		{
+			public:
+				Interactions(Piece& pieceA, Piece& pieceB, const array<int, NumColors>& freeMoves, bool fast);
+				int apply() const;
+
+			private:
+				std::unique_ptr<array<State, 2>> m_states;    /**< States of both pieces after playing all their moves, if they may interact. */
+				int m_requiredMoves;                          /**< Number of moves required by both pieces. */
+				bool m_fast;                                  /**< Set if only required moves were computed. */
+		};
+
+		class Obstructions
+		{
+			public:
+				const array<int, NumSquares>& distancesTo(const Piece& piece, const Piece& blocker, Square obstruction);
+
+			private:
+				typedef std::tuple<const Piece *, int, Glyph, Square> Key;
+
+				std::map<Key, array<int, NumSquares>> m_distances;    /**< Distances to final squares of pieces, for each epoch, blocking glyph and obstructed square. */
+				std::mutex m_mutex;                                    /**< Mutex protecting above map, which is shared by all threads. */
+		};
+
 	private:
 		Man m_man;                                     /**< Piece's man. */
 		Glyph m_child;                                 /**< Piece's initial glyph, for promoted pawns. */
@@ -257,6 +311,9 @@ class Piece
 		array<int, NumSquares> m_captures;             /**< Number of captures required to reach each square. */
 		array<int, NumSquares> m_rcaptures;            /**< Number of moves required to reach one of the final squares. */
 
+		Paths m_paths;                                 /**< Shortest paths from initial square, kept to update distances when moves are removed. */
+		Paths m_rpaths;                                /**< Shortest paths to final squares, kept to update distances when moves are removed. */
+
 		ArrayOfSquares m_moves;                        /**< Set of legal moves. */
 		const ArrayOfSquares *m_xmoves;                /**< Set of moves that must be captures, or null if there are no restrictions. */
 		const MatrixOfSquares *m_constraints;          /**< Move constraints, i.e. squares that must be empty for each possible move. */
@@ -289,16 +346,7 @@ class Piece
 		Actions *m_actions;                            /**< Actions associated with possible piece moves and their consequences. */
 
 		bool m_update;                                 /**< Set when deductions must be updated and update() shall return true. */
-
-	public:
-		mutable struct {
-			Glyph glyph;                               /**< Piece current glyph, different than initial if promoted. */
-			Square square;                             /**< Piece current square, NoWhere if captured. */
-			int moves;                                 /**< Number of moves played. */
-
-			int assignedMoves;                         /**< Assigned number of moves. */
-
-		} state;                                       /**< State, used when playing possible games, stored here for performance reasons. */
+		int m_epoch;                                   /**< Incremented each time update() returns true, to detect unchanged pieces. */
 };
 
 /* -------------------------------------------------------------------------- */
@@ -307,6 +355,13 @@ class Piece
 
 class Pieces : public std::vector<Piece> {};
 
+/* -------------------------------------------------------------------------- */
+/* -- Tandems                                                              -- */
+/* -------------------------------------------------------------------------- */
+
+struct Tandem { const Piece& pieceA; const Piece& pieceB; int requiredMoves; Tandem(const Piece& pieceA, const Piece& pieceB, int requiredMoves) : pieceA(pieceA), pieceB(pieceB), requiredMoves(requiredMoves) {}};
+class Tandems : public std::vector<Tandem> {};
+
 /* -------------------------------------------------------------------------- */
 
 }
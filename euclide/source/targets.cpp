@@ -40,48 +40,102 @@ bool Target::updatePossibleMen(Men men)
 	return true;
 }
 
+/* -------------------------------------------------------------------------- */
+/* -- Targets                                                              -- */
 /* -------------------------------------------------------------------------- */
 
-bool Target::applyPigeonHolePrinciple(Targets& targets, Captures& captures) const
+static bool augment(int variable, const std::vector<Men>& domains, array<int, MaxPieces>& owners, std::vector<Man>& matches, Men& visited)
 {
-	bool updated = false;
-
-	Squares squares;
-	for (const Target& target : targets)
-		if (target.men() == m_men)
-			squares.set(target.square());
+	/* -- Find an alternating path from given variable to a free man -- */
 
-	if (squares.count() >= m_men.count())
+	for (Man man : ValidMen(domains[variable]))
 	{
-		for (Target& target : targets)
-			if (target.men() != m_men)
-				if (target.updatePossibleMen(~m_men))
-					updated = true;
-
-		for (Capture& capture : captures)
-			if (capture.updatePossibleMen(~m_men, capture.xmen()))
-				updated = true;
+		if (visited[man])
+			continue;
+
+		visited.set(man);
+
+		if ((owners[man] < 0) || augment(owners[man], domains, owners, matches, visited))
+		{
+			owners[man] = variable;
+			matches[variable] = man;
+			return true;
+		}
 	}
 
-	return updated;
+	return false;
 }
 
-/* -------------------------------------------------------------------------- */
-/* -- Targets                                                              -- */
 /* -------------------------------------------------------------------------- */
 
 bool Targets::update(Captures& captures)
 {
-	bool reduced = false;
-	for (bool updated = true; updated; reduced |= updated)
+	/* -- Targets and captures must all be assigned distinct men -- */
+
+	std::vector<Men> domains;
+	domains.reserve(size() + captures.size());
+
+	for (const Target& target : *this)
+		domains.push_back(target.men());
+	for (const Capture& capture : captures)
+		domains.push_back(capture.men());
+
+	const int variables = static_cast<int>(domains.size());
+
+	/* -- Find a maximum matching, that must cover all targets and captures -- */
+
+	array<int, MaxPieces> owners;
+	owners.fill(-1);
+
+	std::vector<Man> matches(variables, -1);
+
+	for (int variable = 0; variable < variables; variable++)
+	{
+		Men visited;
+		if (!augment(variable, domains, owners, matches, visited))
+			throw NoSolution;
+	}
+
+	const Men unmatched([&](Man man) { return owners[man] < 0; });
+
+	/* -- Compute men reachable from each man through alternating paths -- */
+
+	array<Men, MaxPieces> reachable;
+	for (Man man : AllMen())
+		reachable[man] = Men(man);
+
+	for (bool updated = true; updated; )
 	{
 		updated = false;
-		for (const Target& target : *this)
-			if (target.applyPigeonHolePrinciple(*this, captures))
-				updated = true;
+		for (Man man : AllMen())
+		{
+			if (owners[man] < 0)
+				continue;
+
+			Men men = reachable[man];
+			for (Man next : ValidMen(domains[owners[man]]))
+				men |= reachable[next];
+
+			if (men != reachable[man])
+				reachable[man] = men, updated = true;
+		}
 	}
 
-	return reduced;
+	/* -- Keep only men that belong to some maximum matching, either on an alternating cycle or on an alternating path to a free man -- */
+
+	bool updated = false;
+	for (int variable = 0; variable < variables; variable++)
+	{
+		const Man match = matches[variable];
+		const Men men([&](Man man) { return (man == match) || reachable[man][match] || (reachable[man] & unmatched); }, ValidMen(domains[variable]));
+
+		if (variable < int(size()))
+			updated |= (*this)[variable].updatePossibleMen(men);
+		else
+			updated |= captures[variable - size()].updatePossibleMen(men, captures[variable - size()].xmen());
+	}
+
+	return updated;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -0,0 +1,63 @@
+#ifndef __EUCLIDE_DEQUE_H
+#define __EUCLIDE_DEQUE_H
+
+#include "../includes.h"
+
+namespace Euclide
+{
+
+/* -------------------------------------------------------------------------- */
+
+template <typename T>
+class Deque
+{
+	public:
+		Deque() : m_deque(16), m_out(0), m_size(0) {}
+
+		inline void clear()
+			{ m_out = m_size = 0; }
+
+		inline void push_back(const T& value)
+			{ if (full()) grow(); m_deque[(m_out + m_size++) & mask()] = value; }
+		inline void push_front(const T& value)
+			{ if (full()) grow(); m_out = (m_out - 1) & mask(); m_deque[m_out] = value; m_size++; }
+		inline void pop_front()
+			{ assert(m_size > 0); m_out = (m_out + 1) & mask(); m_size -= 1; }
+
+		inline const T& front() const
+			{ assert(m_size > 0); return m_deque[m_out]; }
+		inline const T& back() const
+			{ assert(m_size > 0); return m_deque[(m_out + m_size - 1) & mask()]; }
+
+		inline bool empty() const
+			{ return m_size == 0; }
+		inline size_t size() const
+			{ return m_size; }
+
+	protected:
+		inline bool full() const
+			{ return m_size >= m_deque.size(); }
+		inline size_t mask() const
+			{ return m_deque.size() - 1; }
+
+		void grow()
+		{
+			std::vector<T> deque(2 * m_deque.size());
+			for (size_t k = 0; k < m_size; k++)
+				deque[k] = m_deque[(m_out + k) & mask()];
+
+			m_deque.swap(deque);
+			m_out = 0;
+		}
+
+	private:
+		std::vector<T> m_deque;    /**< Ring buffer of queued elements, its size is a power of two and doubles when full. */
+		size_t m_out;              /**< Index, in above buffer, of front element. */
+		size_t m_size;             /**< Number of elements in deque. */
+};
+
+/* -------------------------------------------------------------------------- */
+
+}
+
+#endif
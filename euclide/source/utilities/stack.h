@@ -0,0 +1,50 @@
+#ifndef __EUCLIDE_STACK_H
+#define __EUCLIDE_STACK_H
+
+#include "../includes.h"
+
+namespace Euclide
+{
+
+/* -------------------------------------------------------------------------- */
+
+template <typename T, size_t MaxSize>
+class Stack
+{
+	public:
+		constexpr Stack() : m_size(0) {}
+
+		inline void push(const T& value)
+			{ assert(m_size < MaxSize); m_stack[m_size++] = value; }
+		inline void pop()
+			{ assert(m_size > 0); m_size -= 1; }
+
+		inline const T& back() const
+			{ assert(m_size > 0); return m_stack[m_size - 1]; }
+		inline const T& operator[](size_t index) const
+			{ assert(index < m_size); return m_stack[index]; }
+
+		inline const T *data() const
+			{ return m_stack.data(); }
+		inline const T *begin() const
+			{ return m_stack.data(); }
+		inline const T *end() const
+			{ return m_stack.data() + m_size; }
+
+		inline constexpr bool empty() const
+			{ return m_size == 0; }
+		inline constexpr bool full() const
+			{ return m_size >= MaxSize; }
+		inline constexpr size_t size() const
+			{ return m_size; }
+
+	private:
+		array<T, MaxSize> m_stack;    /**< Stacked elements. No more than MaxSize elements can be on the stack at once. */
+		size_t m_size;                /**< Number of elements on the stack. */
+};
+
+/* -------------------------------------------------------------------------- */
+
+}
+
+#endif
@@ -8,6 +8,7 @@ set problems=%problems%;single-capture.txt
 set problems=%problems%;natch-test-problems.txt
 set problems=%problems%;bichromatic.txt
 set problems=%problems%;edupuis.txt
+set problems=%problems%;castling-kings.txt
 
 set euclide=..\euclide-console\bin\euclide-console.exe
 